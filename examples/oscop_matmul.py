@@ -3,7 +3,7 @@
 #  Distributed under the Boost Software License, Version 1.0. (See accompanying
 #  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 from phylanx.ast.oscop import *
-from phylanx.ast.transformation import Phylanx
+from phylanx.ast.transducer import Phylanx
 
 N = 10
 A = [[0. for i in range(N + 1)] for j in range(N + 1)]
@@ -14,7 +14,7 @@ M = 2
 
 
 # matrix multiply
-@Phylanx("OpenSCoP")
+@Phylanx(target="OpenSCoP")
 def kernel():
     if N > 0:
         for i in range(N):
@@ -7,6 +7,7 @@
 #define PHYLANX_EXECUTION_TREE_ACTORS_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/placement.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 
 #include <hpx/include/util.hpp>
@@ -370,6 +371,14 @@ namespace phylanx { namespace execution_tree { namespace compiler
         std::size_t compile_id_;    // sequence number of this compiler invocation
         program program_;           // storage for top-level code
         std::map<std::string, std::size_t> sequence_numbers_;
+        placement_report placement_;    // placement decisions of the compiler
+
+        // arguments and bodies of the named functions defined so far, keyed
+        // by the name of the function object, used by source transformations
+        // like grad()
+        std::map<std::string,
+                std::pair<std::vector<ast::expression>, ast::expression>>
+            function_definitions_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,36 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_AUTODIFF_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_AUTODIFF_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <string>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    /// Generate the body of a function calculating the gradient of the given
+    /// function body with respect to the variable `wrt` (reverse mode
+    /// automatic differentiation).
+    ///
+    /// The generated code evaluates the original expression once while
+    /// recording all intermediate values in variables (the tape), followed
+    /// by a single backward sweep accumulating the adjoints. The tape
+    /// variables are created once at compile time and are reused by all
+    /// invocations of the gradient function. The gradient function is
+    /// therefore not reentrant: concurrent invocations (e.g. from
+    /// parallel_map) are serialized using critical().
+    ///
+    /// If the function returns an array, the gradient of the sum of its
+    /// elements is calculated.
+    PHYLANX_EXPORT ast::expression differentiate(ast::expression const& body,
+        std::string const& wrt, expression_pattern_list const& patterns,
+        std::string const& codename = "<unknown>");
+}}}
+
+#endif
@@ -74,6 +74,11 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 std::move(elements), std::move(name_parts), codename);
         }
 
+        hpx::id_type const& locality() const
+        {
+            return locality_;
+        }
+
     protected:
         hpx::id_type locality_;
     };
@@ -87,6 +92,12 @@ namespace phylanx { namespace execution_tree { namespace compiler
           , f_(f)
         {}
 
+        // create the same built-in function on a different locality
+        builtin_function placed_on(hpx::id_type const& locality) const
+        {
+            return builtin_function(f_, locality);
+        }
+
         function compose(std::list<function>&& args,
             primitive_name_parts&& name_parts,
             std::string const& codename) const
@@ -0,0 +1,68 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_PLACEMENT_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_PLACEMENT_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/naming.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The compiler places a primitive on the locality which holds most of
+    // its operands (see phylanx.placement). If requested, each placement
+    // decision is recorded to be able to report the resulting
+    // cross-locality traffic.
+    struct placement_entry
+    {
+        std::string name;               // name of the placed primitive
+        std::uint32_t locality;         // locality the primitive was placed on
+        std::size_t operands;           // number of operands
+        std::size_t remote_operands;    // operands living elsewhere
+        std::size_t literal_bytes;      // literal data shipped on creation
+    };
+
+    struct placement_report
+    {
+        /// Number of operand edges crossing locality boundaries, each of
+        /// those results in a parcel being sent whenever the primitive is
+        /// evaluated
+        PHYLANX_EXPORT std::size_t cross_locality_operands() const;
+
+        /// Number of bytes of literal operands which were sent to other
+        /// localities while creating the primitives
+        PHYLANX_EXPORT std::size_t shipped_literal_bytes() const;
+
+        /// Record the placement decisions (off by default, the entries
+        /// would otherwise accumulate for every compiled primitive)
+        bool enabled = false;
+
+        std::vector<placement_entry> entries;
+    };
+
+    /// Return the id of the locality the given operand lives on or
+    /// hpx::naming::invalid_locality_id if it is not a primitive
+    PHYLANX_EXPORT std::uint32_t operand_locality(
+        primitive_argument_type const& operand);
+
+    /// Return the (approximate) number of bytes needed to send the given
+    /// literal operand, primitives are not accounted for
+    PHYLANX_EXPORT std::size_t literal_operand_size(
+        primitive_argument_type const& operand);
+
+    /// Produce a human readable summary of the given report
+    PHYLANX_EXPORT std::string format_placement_report(
+        placement_report const& report);
+}}}
+
+#endif
@@ -585,6 +585,27 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT bool is_list_operand_strict(
         primitive_argument_type const& val);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Return whether the given value represents an array partitioned over
+    // the localities (see partition() in the dist_matrixops plugin).
+    PHYLANX_EXPORT bool is_partitioned_operand(
+        primitive_argument_type const& val);
+    PHYLANX_EXPORT bool any_partitioned_operand(
+        primitive_arguments_type const& vals);
+
+    // Evaluate the distributed primitive of the given type (e.g. "add_d")
+    // for the given values, at least one of which is partitioned. This is
+    // used by the local primitives to hand partitioned operands over to
+    // their distributed counterparts. More than two values are combined
+    // from left to right.
+    PHYLANX_EXPORT primitive_argument_type partitioned_operation(
+        std::string const& type, primitive_arguments_type&& vals,
+        std::string const& codename = "<unknown>");
+    PHYLANX_EXPORT primitive_argument_type partitioned_operation(
+        std::string const& type, primitive_argument_type&& lhs,
+        primitive_argument_type&& rhs,
+        std::string const& codename = "<unknown>");
+
     ///////////////////////////////////////////////////////////////////////////
     // Extract a primitive from a given primitive_argument_type, throw
     // if it doesn't hold one.
@@ -0,0 +1,56 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_CRITICAL_SECTION)
+#define PHYLANX_PRIMITIVES_CRITICAL_SECTION
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/mutex.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Evaluate an expression while no other evaluation of the same
+    /// critical() instance is in progress. This protects code using shared
+    /// variables as scratch space (e.g. the tape of grad()) from concurrent
+    /// invocations of the function it belongs to.
+    class critical_section
+      : public primitive_component_base
+      , public std::enable_shared_from_this<critical_section>
+    {
+    public:
+        static match_pattern_type const match_data;
+
+        critical_section() = default;
+
+        critical_section(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& args,
+            eval_mode) const override;
+
+    private:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+        using mutex_type = hpx::lcos::local::mutex;
+        mutable mutex_type mtx_;
+    };
+
+    PHYLANX_EXPORT primitive create_critical_section(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "");
+}}}
+
+#endif
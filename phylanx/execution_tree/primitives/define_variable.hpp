@@ -30,6 +30,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         static match_pattern_type const match_data;
         static match_pattern_type const match_data_define;
         static match_pattern_type const match_data_lambda;
+        static match_pattern_type const match_data_grad;
 
         define_variable() = default;
 
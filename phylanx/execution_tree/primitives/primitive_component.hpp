@@ -91,8 +91,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         PHYLANX_EXPORT std::int64_t get_eval_count(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_eval_duration(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_direct_execution(bool reset) const;
-
-        PHYLANX_EXPORT void enable_measurements();
+        PHYLANX_EXPORT std::int64_t get_allocated_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_largest_result_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_copy_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_size_class_eval_count(
+            std::size_t size_class, bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_size_class_eval_duration(
+            std::size_t size_class, bool reset) const;
+
+        PHYLANX_EXPORT void enable_measurements(bool size_histogram = false);
 
         // decide whether to execute eval directly
         PHYLANX_EXPORT static hpx::launch select_direct_execution(
@@ -9,12 +9,14 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/eval_trace.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -88,8 +90,42 @@ namespace phylanx { namespace execution_tree
             std::int64_t get_eval_count(bool reset) const;
             std::int64_t get_eval_duration(bool reset) const;
             std::int64_t get_direct_execution(bool reset) const;
-
-            void enable_measurements();
+            std::int64_t get_allocated_bytes(bool reset) const;
+            std::int64_t get_largest_result_bytes(bool reset) const;
+            std::int64_t get_copy_count(bool reset) const;
+
+            // eval count and duration bucketed by the number of elements
+            // involved (size class k holds evaluations of [2^k, 2^(k+1))
+            // elements, size class zero holds zero or one element)
+            static constexpr std::size_t num_size_classes = 32;
+            static std::size_t size_class(std::int64_t elements);
+
+            std::int64_t get_size_class_eval_count(
+                std::size_t size_class, bool reset) const;
+            std::int64_t get_size_class_eval_duration(
+                std::size_t size_class, bool reset) const;
+
+            void enable_measurements(bool size_histogram = false);
+
+            // attribute the memory held by the result of eval to this
+            // primitive
+            hpx::future<primitive_argument_type> account_memory(
+                hpx::future<primitive_argument_type>&& f) const;
+
+            // attribute the duration of eval to the size class of the
+            // largest argument or result
+            hpx::future<primitive_argument_type> record_size_class(
+                hpx::future<primitive_argument_type>&& f,
+                std::int64_t elements, std::int64_t start) const;
+
+            // record the evaluation of this primitive in the timeline, if
+            // enabled
+            util::eval_trace_event begin_eval_trace(
+                primitive_argument_type const* args,
+                std::size_t num_args) const;
+            hpx::future<primitive_argument_type> end_eval_trace(
+                hpx::future<primitive_argument_type>&& f,
+                util::eval_trace_event const& event) const;
 
             // decide whether to execute eval directly
             hpx::launch select_direct_eval_execution(hpx::launch policy) const;
@@ -126,8 +162,21 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t eval_count_;
             mutable std::int64_t eval_duration_;
             mutable std::int64_t execute_directly_;
+            mutable std::int64_t allocated_bytes_;
+            mutable std::int64_t largest_result_bytes_;
+            mutable std::int64_t copy_count_;
             bool measurements_enabled_;
 
+            struct size_class_data
+            {
+                std::array<std::int64_t, num_size_classes> eval_count_;
+                std::array<std::int64_t, num_size_classes> eval_duration_;
+            };
+            std::unique_ptr<size_class_data> size_histogram_;
+
+            // name of this primitive as used by the timeline recorder
+            mutable char const* trace_name_;
+
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
 #endif
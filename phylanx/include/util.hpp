@@ -7,6 +7,8 @@
 #define PHYLANX_UTIL_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/bit_mask.hpp>
+#include <phylanx/util/eval_trace.hpp>
 #include <phylanx/util/performance_data.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/serialization/ast.hpp>
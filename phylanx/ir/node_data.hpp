@@ -12,6 +12,7 @@
 
 #include <hpx/include/serialization.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 
 #include <array>
@@ -355,6 +356,24 @@ namespace phylanx { namespace ir
         bool enabled_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Attribute all copies of node_data instances (of any type) performed by
+    /// the current HPX thread to the given counter for the lifetime of this
+    /// object. Scopes nest, the innermost one receives the counts. Copies
+    /// performed by other HPX threads (e.g. asynchronous continuations) are
+    /// not attributed.
+    struct PHYLANX_EXPORT scoped_copy_count
+    {
+        explicit scoped_copy_count(std::int64_t* count);
+        ~scoped_copy_count();
+
+        scoped_copy_count(scoped_copy_count const&) = delete;
+        scoped_copy_count& operator=(scoped_copy_count const&) = delete;
+
+        hpx::threads::thread_id_type id_;
+        std::int64_t* prev_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     PHYLANX_EXPORT bool operator==(
         node_data<double> const& lhs, node_data<double> const& rhs);
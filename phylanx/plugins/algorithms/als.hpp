@@ -12,6 +12,8 @@
 
 #include <hpx/lcos/future.hpp>
 
+#include <blaze/Math.h>
+
 #include <memory>
 #include <string>
 #include <utility>
@@ -49,6 +51,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
     protected:
         primitive_argument_type calculate_als(
             primitive_arguments_type&& args) const;
+
+        // ratings given either as a (dense) matrix or in coordinate form
+        blaze::CompressedMatrix<double> extract_ratings(
+            primitive_argument_type const& arg) const;
     };
 
     inline primitive create_als(hpx::id_type const& locality,
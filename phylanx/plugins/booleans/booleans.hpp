@@ -10,6 +10,7 @@
 #include <phylanx/plugins/booleans/and_operation.hpp>
 #include <phylanx/plugins/booleans/any_operation.hpp>
 #include <phylanx/plugins/booleans/equal.hpp>
+#include <phylanx/plugins/booleans/fused_where.hpp>
 #include <phylanx/plugins/booleans/greater.hpp>
 #include <phylanx/plugins/booleans/greater_equal.hpp>
 #include <phylanx/plugins/booleans/less.hpp>
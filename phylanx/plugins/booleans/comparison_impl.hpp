@@ -12,6 +12,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/ir/ranges.hpp>
 #include <phylanx/plugins/booleans/comparison.hpp>
+#include <phylanx/util/detail/predicate_simd.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -60,17 +61,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         bool propagate_type) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
             rhs = blaze::map(rhs.vector(),
-                [&](T x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
         else
         {
             rhs.vector() = blaze::map(rhs.vector(),
-                [&](T x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
 
         if (propagate_type)
@@ -87,17 +88,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         bool propagate_type) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
             rhs = blaze::map(rhs.matrix(),
-                [&](T x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
         else
         {
             rhs.matrix() = blaze::map(rhs.matrix(),
-                [&](T x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
 
         if (propagate_type)
@@ -145,17 +146,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         bool propagate_type) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.vector(),
-                [&](T x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
         else
         {
             lhs.vector() = blaze::map(lhs.vector(),
-                [&](T x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
 
         if (propagate_type)
@@ -184,17 +185,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.vector(), rhs.vector(),
-                [&](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         else
         {
             lhs.vector() = blaze::map(lhs.vector(), rhs.vector(),
-                [&](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         if (propagate_type)
@@ -223,17 +222,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
-            blaze::DynamicMatrix<double> m{cm.rows(), cm.columns()};
+            blaze::DynamicMatrix<T> m{cm.rows(), cm.columns()};
 
             for (size_t i = 0UL; i != cm.rows(); ++i)
             {
                 blaze::row(m, i) = blaze::map(blaze::row(cm, i),
                     blaze::trans(cv),
-                    [](T x, T y) { return Op{}(x, y); });
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
             }
 
             if (propagate_type)
@@ -248,7 +245,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             blaze::row(cm, i) = blaze::map(blaze::row(cm, i),
                 blaze::trans(cv),
-                [](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         if (propagate_type)
@@ -299,17 +296,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::size_t lhs_size = lhs.dimension(0);
         std::size_t rhs_size = rhs.dimension(0);
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.matrix(),
-                [&](T x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
         else
         {
             lhs.matrix() = blaze::map(lhs.matrix(),
-                [&](T x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
 
         if (propagate_type)
@@ -338,17 +335,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
-            blaze::DynamicMatrix<double> m{cm.rows(), cm.columns()};
+            blaze::DynamicMatrix<T> m{cm.rows(), cm.columns()};
 
             for (size_t i = 0UL; i != cm.rows(); ++i)
             {
                 blaze::row(m, i) = blaze::map(blaze::row(cm, i),
                     blaze::trans(cv),
-                    [](T x, T y) { return Op{}(x, y); });
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
             }
 
             if (propagate_type)
@@ -363,7 +358,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             blaze::row(cm, i) = blaze::map(blaze::row(cm, i),
                 blaze::trans(cv),
-                [](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         if (propagate_type)
@@ -392,17 +387,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        //       is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.matrix(), rhs.matrix(),
-                [&](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         else
         {
             lhs.matrix() = blaze::map(lhs.matrix(), rhs.matrix(),
-                [&](T x, T y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         if (propagate_type)
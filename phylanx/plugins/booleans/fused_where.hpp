@@ -0,0 +1,134 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FUSED_WHERE_HPP)
+#define PHYLANX_PRIMITIVES_FUSED_WHERE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Fused version of where(lhs <op> rhs, a, b) which compares and selects
+    /// in a single pass without materializing the boolean condition. The
+    /// compiler maps calls to where() whose first argument is a comparison
+    /// onto this primitive (see configuration entry 'phylanx.fuse_where').
+    class fused_where
+      : public primitive_component_base
+      , public std::enable_shared_from_this<fused_where>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        enum comparison_kind
+        {
+            compare_eq, compare_ne, compare_lt,
+            compare_le, compare_gt, compare_ge
+        };
+
+        static std::vector<match_pattern_type> const match_data;
+
+        fused_where() = default;
+
+        fused_where(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+
+    private:
+        template <typename Op, typename C, typename R>
+        primitive_argument_type fused_where_elements(
+            primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+            primitive_argument_type&& a, primitive_argument_type&& b) const;
+
+        template <typename C, typename R>
+        primitive_argument_type fused_where_elements(
+            primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+            primitive_argument_type&& a, primitive_argument_type&& b) const;
+
+        template <typename C>
+        primitive_argument_type fused_where_elements(
+            primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+            primitive_argument_type&& a, primitive_argument_type&& b) const;
+
+        // operand types for which the fused evaluation differs from
+        // where(lhs <op> rhs, a, b) are handled by the unfused primitives
+        bool is_fusable(primitive_argument_type const& lhs,
+            primitive_argument_type const& rhs,
+            primitive_argument_type const& a,
+            primitive_argument_type const& b) const;
+
+        primitive_argument_type unfused_where(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs, primitive_argument_type&& a,
+            primitive_argument_type&& b) const;
+
+        comparison_kind kind_;
+    };
+
+    inline primitive create_where_eq(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_eq", std::move(operands), name, codename);
+    }
+
+    inline primitive create_where_ne(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_ne", std::move(operands), name, codename);
+    }
+
+    inline primitive create_where_lt(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_lt", std::move(operands), name, codename);
+    }
+
+    inline primitive create_where_le(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_le", std::move(operands), name, codename);
+    }
+
+    inline primitive create_where_gt(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_gt", std::move(operands), name, codename);
+    }
+
+    inline primitive create_where_ge(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__where_ge", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
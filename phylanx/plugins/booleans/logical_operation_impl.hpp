@@ -11,6 +11,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/logical_operation.hpp>
+#include <phylanx/util/detail/predicate_simd.hpp>
 #include <phylanx/ir/ranges.hpp>
 
 #include <hpx/include/lcos.hpp>
@@ -216,17 +217,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type logical_operation<Op>::logical0d1d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
             rhs = blaze::map(rhs.vector(),
-                [&](bool x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
         else
         {
             rhs.vector() = blaze::map(rhs.vector(),
-                [&](bool x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
 
         return primitive_argument_type(
@@ -238,17 +239,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type logical_operation<Op>::logical0d2d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
             rhs = blaze::map(rhs.matrix(),
-                [&](bool x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
         else
         {
             rhs.matrix() = blaze::map(rhs.matrix(),
-                [&](bool x) { return Op{}(x, lhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    lhs.scalar()));
         }
 
         return primitive_argument_type(
@@ -287,17 +288,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type logical_operation<Op>::logical1d0d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
     {
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.vector(),
-                [&](bool x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
         else
         {
             lhs.vector() = blaze::map(lhs.vector(),
-                [&](bool x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
 
         return primitive_argument_type(
@@ -321,17 +322,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.vector(), rhs.vector(),
-                [&](bool x, bool y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         else
         {
             lhs.vector() = blaze::map(lhs.vector(), rhs.vector(),
-                [&](bool x, bool y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         return primitive_argument_type(
@@ -355,16 +354,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (rhs.is_ref())
         {
             blaze::DynamicMatrix<std::uint8_t> m{cm.rows(), cm.columns()};
             for (std::size_t i = 0UL; i != cm.rows(); ++i)
             {
-                blaze::row(m, i) =
-                    blaze::map(blaze::row(cm, i), blaze::trans(cv),
-                        [](bool x, bool y) { return Op{}(x, y); });
+                blaze::row(m, i) = blaze::map(blaze::row(cm, i),
+                    blaze::trans(cv),
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
             }
             return primitive_argument_type(
                 ir::node_data<std::uint8_t>{std::move(m)});
@@ -374,7 +371,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             blaze::row(cm, i) =
                 blaze::map(blaze::row(cm, i), blaze::trans(cv),
-                    [](bool x, bool y) { return Op{}(x, y); });
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         return primitive_argument_type(
             ir::node_data<std::uint8_t>{std::move(rhs)});
@@ -414,17 +411,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::size_t lhs_size = lhs.dimension(0);
         std::size_t rhs_size = rhs.dimension(0);
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.matrix(),
-                [&](bool x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
         else
         {
             lhs.matrix() = blaze::map(lhs.matrix(),
-                [&](bool x) { return Op{}(x, rhs.scalar()); });
+                util::detail::predicatend0d_simd<typename Op::simd_op, T>(
+                    rhs.scalar()));
         }
 
         return primitive_argument_type(
@@ -448,16 +445,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             blaze::DynamicMatrix<std::uint8_t> m{cm.rows(), cm.columns()};
             for (std::size_t i = 0UL; i != cm.rows(); ++i)
             {
-                blaze::row(m, i) =
-                    blaze::map(blaze::row(cm, i), blaze::trans(cv),
-                        [](bool x, bool y) { return Op{}(x, y); });
+                blaze::row(m, i) = blaze::map(blaze::row(cm, i),
+                    blaze::trans(cv),
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
             }
             return primitive_argument_type(
                 ir::node_data<std::uint8_t>{std::move(m)});
@@ -467,7 +462,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             blaze::row(cm, i) =
                 blaze::map(blaze::row(cm, i), blaze::trans(cv),
-                    [](bool x, bool y) { return Op{}(x, y); });
+                    util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         return primitive_argument_type(
             ir::node_data<std::uint8_t>{std::move(lhs)});
@@ -490,17 +485,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        // TODO: SIMD functionality should be added, blaze implementation
-        // is not currently available
         if (lhs.is_ref())
         {
             lhs = blaze::map(lhs.matrix(), rhs.matrix(),
-                [&](bool x, bool y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
         else
         {
             lhs.matrix() = blaze::map(lhs.matrix(), rhs.matrix(),
-                [&](bool x, bool y) { return Op{}(x, y); });
+                util::detail::predicatendnd_simd<typename Op::simd_op>{});
         }
 
         return primitive_argument_type(
@@ -0,0 +1,64 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PARALLEL_FOR_EACH_HPP)
+#define PHYLANX_PARALLEL_FOR_EACH_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/ranges.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Invoke a function for each element of a range, the iterations are
+    /// independent of each other and are executed concurrently in chunks of
+    /// (optionally) given size.
+    class parallel_for_each
+      : public primitive_component_base
+      , public std::enable_shared_from_this<parallel_for_each>
+    {
+    public:
+        static match_pattern_type const match_data;
+
+        parallel_for_each() = default;
+
+        parallel_for_each(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& args,
+            eval_mode mode) const override;
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_mode mode) const;
+
+    private:
+        hpx::future<primitive_argument_type> iterate(
+            primitive_argument_type&& bound_func, ir::range&& list,
+            std::int64_t grain_size, eval_mode mode) const;
+    };
+
+    inline primitive create_parallel_for_each(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "parallel_for_each", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
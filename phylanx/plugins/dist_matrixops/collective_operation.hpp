@@ -0,0 +1,98 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_COLLECTIVE_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_COLLECTIVE_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Collective operations (all_reduce, broadcast, gather) involving all
+    /// localities. Every locality has to execute the same code (SPMD), the
+    /// contributions of the localities are matched by the name of the
+    /// primitive and the number of times it was evaluated.
+    class collective_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<collective_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        enum collective_type
+        {
+            all_reduce_collective,
+            broadcast_collective,
+            gather_collective
+        };
+
+        static std::vector<match_pattern_type> const match_data;
+
+        collective_operation() = default;
+
+        collective_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+
+    private:
+        primitive_argument_type all_reduce(primitive_argument_type&& value,
+            std::string const& op, std::string const& key) const;
+        primitive_argument_type broadcast(primitive_argument_type&& value,
+            std::uint32_t root, std::string const& key) const;
+        primitive_argument_type gather(primitive_argument_type&& value,
+            std::uint32_t root, std::string const& key) const;
+
+        primitive_argument_type collective(primitive_argument_type&& value,
+            primitive_argument_type&& param) const;
+
+    private:
+        collective_type type_;
+        mutable std::atomic<std::size_t> generation_;
+    };
+
+    inline primitive create_all_reduce_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "all_reduce", std::move(operands), name, codename);
+    }
+
+    inline primitive create_broadcast_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "broadcast", std::move(operands), name, codename);
+    }
+
+    inline primitive create_gather_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "gather", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
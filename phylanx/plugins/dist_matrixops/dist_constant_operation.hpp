@@ -0,0 +1,61 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DIST_CONSTANT_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_DIST_CONSTANT_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Create a partitioned array filled with a constant value. Each tile is
+    /// created on the locality owning it, the array as a whole never exists
+    /// on a single locality.
+    class dist_constant_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<dist_constant_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        static match_pattern_type const match_data;
+
+        dist_constant_operation() = default;
+
+        dist_constant_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+
+    private:
+        primitive_argument_type constant(primitive_argument_type&& value,
+            ir::range&& shape, std::size_t num_partitions) const;
+    };
+
+    inline primitive create_dist_constant_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "constant_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
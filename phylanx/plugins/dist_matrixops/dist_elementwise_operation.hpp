@@ -0,0 +1,87 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DIST_ELEMENTWISE_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_DIST_ELEMENTWISE_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Elementwise arithmetic (add_d, sub_d, mul_d, div_d) on partitioned
+    /// arrays. Each partition of the result is computed on the locality
+    /// owning the corresponding partition of the operands, local operands
+    /// are broadcast or split into matching blocks of rows.
+    class dist_elementwise_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<dist_elementwise_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        dist_elementwise_operation() = default;
+
+        dist_elementwise_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+
+    private:
+        primitive_argument_type elementwise(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs) const;
+
+        std::string operation_;     // type of the local primitive
+    };
+
+    inline primitive create_add_d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "add_d", std::move(operands), name, codename);
+    }
+
+    inline primitive create_sub_d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "sub_d", std::move(operands), name, codename);
+    }
+
+    inline primitive create_mul_d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "mul_d", std::move(operands), name, codename);
+    }
+
+    inline primitive create_div_d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "div_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
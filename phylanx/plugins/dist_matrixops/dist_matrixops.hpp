@@ -0,0 +1,18 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_DIST_MATRIXOPS_PRIMITIVES_HPP)
+#define PHYLANX_PLUGINS_DIST_MATRIXOPS_PRIMITIVES_HPP
+
+#include <phylanx/plugins/dist_matrixops/collective_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_constant_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_dot_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_elementwise_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_sum_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partition_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#endif
@@ -0,0 +1,56 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DIST_TRANSPOSE_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_DIST_TRANSPOSE_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Transpose of a row-partitioned matrix. Partition j of the result is
+    /// assembled on the locality owning partition j of the operand from the
+    /// corresponding column blocks of all partitions.
+    class dist_transpose_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<dist_transpose_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        static match_pattern_type const match_data;
+
+        dist_transpose_operation() = default;
+
+        dist_transpose_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+    };
+
+    inline primitive create_dist_transpose_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "transpose_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
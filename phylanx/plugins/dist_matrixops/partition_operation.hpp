@@ -0,0 +1,73 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PARTITION_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_PARTITION_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// partition() splits a vector or matrix into blocks of rows which are
+    /// distributed over all localities, unpartition() collects a partitioned
+    /// array back into a local vector or matrix.
+    class partition_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<partition_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args) const;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        partition_operation() = default;
+
+        partition_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_mode) const override;
+
+    private:
+        primitive_argument_type partition(primitive_argument_type&& arg,
+            std::size_t num_partitions) const;
+        primitive_argument_type unpartition(
+            primitive_argument_type&& arg) const;
+
+        bool unpartition_;
+    };
+
+    inline primitive create_partition_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "partition", std::move(operands), name, codename);
+    }
+
+    inline primitive create_unpartition_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "unpartition", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
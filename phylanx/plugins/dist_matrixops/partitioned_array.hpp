@@ -0,0 +1,107 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_DIST_MATRIXOPS_PARTITIONED_ARRAY_HPP)
+#define PHYLANX_PLUGINS_DIST_MATRIXOPS_PARTITIONED_ARRAY_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/naming.hpp>
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A contiguous block of rows (of elements for vectors) of a partitioned
+    /// array. The data of the block is held by a variable primitive living
+    /// on the locality owning the block.
+    struct array_partition
+    {
+        primitive tile;
+        std::size_t begin;      // index of the first row (element)
+        std::size_t size;       // number of rows (elements)
+        std::uint32_t locality; // id of the locality owning the block
+    };
+
+    /// A vector or a matrix which is split into blocks of rows distributed
+    /// over the localities. PhySL code sees a partitioned array as a list
+    /// tagged with "__partitioned" which is created by partition() or
+    /// constant_d() and consumed by the distributed primitives (add_d, dot_d,
+    /// etc.). The local primitives (__add, dot, etc.) forward partitioned
+    /// operands to their distributed counterparts.
+    struct partitioned_array
+    {
+        std::size_t dimensions;     // 1 for vectors, 2 for matrices
+        std::size_t size;           // number of rows (elements for vectors)
+        std::size_t columns;        // number of columns (0 for vectors)
+        std::vector<array_partition> partitions;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return whether the given value represents a partitioned array
+    bool is_partitioned_array(primitive_argument_type const& val);
+
+    /// Decode a partitioned array from the given value
+    partitioned_array extract_partitioned_array(
+        primitive_argument_type const& val, std::string const& name,
+        std::string const& codename);
+
+    /// Encode the given partitioned array as a (PhySL) value
+    primitive_argument_type make_partitioned_array(partitioned_array&& arr);
+
+    /// Return whether both arrays have the same shape and are split into the
+    /// same blocks
+    bool same_layout(
+        partitioned_array const& lhs, partitioned_array const& rhs);
+
+    /// Return the locality owning the given partition
+    hpx::id_type partition_locality(array_partition const& part);
+
+    /// Split the given number of rows (elements) into 'num_partitions'
+    /// blocks (one per locality if zero) which are placed on the localities
+    /// in a round robin fashion. The tiles of the blocks are not created.
+    std::vector<array_partition> make_partition_layout(
+        std::size_t size, std::size_t num_partitions);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create a primitive of the given type on the locality of the given
+    /// partition, evaluate it there, and keep its result in a new variable
+    /// on that locality. Only operands which don't live on that locality are
+    /// transferred.
+    hpx::future<primitive> create_partition_tile(array_partition const& part,
+        std::string const& type, primitive_arguments_type&& operands,
+        std::string const& codename);
+
+    /// Evaluate a primitive of the given type on the locality of the given
+    /// partition and return its result, this is used for reductions.
+    hpx::future<primitive_argument_type> evaluate_on_partition(
+        array_partition const& part, std::string const& type,
+        primitive_arguments_type&& operands, std::string const& codename);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Extract the rows (elements) [begin, begin + size) of a local value
+    primitive_argument_type extract_partition_rows(
+        primitive_argument_type const& val, std::size_t begin,
+        std::size_t size, std::string const& name,
+        std::string const& codename);
+
+    /// Combine the partial results of a reduction by adding them up
+    primitive_argument_type add_partial_results(
+        primitive_arguments_type&& partials, std::string const& codename);
+
+    /// Collect all partitions of the given array into a local vector or
+    /// matrix
+    primitive_argument_type gather_partitioned_array(
+        partitioned_array const& arr, std::string const& name,
+        std::string const& codename);
+}}}
+
+#endif
@@ -0,0 +1,172 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_BIT_MASK_HPP)
+#define PHYLANX_UTIL_BIT_MASK_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        inline std::size_t popcount(std::uint64_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return static_cast<std::size_t>(__popcnt64(word));
+#else
+            word = word - ((word >> 1) & 0x5555555555555555ull);
+            word = (word & 0x3333333333333333ull) +
+                ((word >> 2) & 0x3333333333333333ull);
+            word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return static_cast<std::size_t>(
+                (word * 0x0101010101010101ull) >> 56);
+#endif
+        }
+
+        // word must not be zero
+        inline std::size_t count_trailing_zeros(std::uint64_t word)
+        {
+            HPX_ASSERT(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index = 0;
+            _BitScanForward64(&index, word);
+            return static_cast<std::size_t>(index);
+#else
+            std::size_t index = 0;
+            while ((word & 1) == 0)
+            {
+                word >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        // Pack the results of f(first), ..., f(first + count - 1) into the
+        // low bits of a single word. The loop is branch free, which allows
+        // the compiler to vectorize the evaluation of the predicate.
+        template <typename F>
+        std::uint64_t pack_bits(F const& f, std::size_t first, std::size_t count)
+        {
+            std::uint64_t word = 0;
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                word |= std::uint64_t(f(first + i) ? 1 : 0) << i;
+            }
+            return word;
+        }
+
+        // mask selecting the low 'count' bits of a word, count must be in
+        // the range [1, 64]
+        inline std::uint64_t low_bits(std::size_t count)
+        {
+            return count == 64 ? ~std::uint64_t(0) :
+                (std::uint64_t(1) << count) - 1;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// number of elements whose predicate values are combined into one word
+    constexpr std::size_t mask_bits_per_word = 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Reductions over a predicate which evaluate it one word (64 elements) at
+    // a time without materializing the mask. any and all stop at the first
+    // word deciding the result.
+
+    /// Return whether f(i) is true for any i in [0, size)
+    template <typename F>
+    bool mask_any(std::size_t size, F const& f)
+    {
+        for (std::size_t i = 0; i < size; i += mask_bits_per_word)
+        {
+            std::size_t count = size - i;
+            if (count > mask_bits_per_word)
+            {
+                count = mask_bits_per_word;
+            }
+            if (detail::pack_bits(f, i, count) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Return whether f(i) is true for all i in [0, size)
+    template <typename F>
+    bool mask_all(std::size_t size, F const& f)
+    {
+        for (std::size_t i = 0; i < size; i += mask_bits_per_word)
+        {
+            std::size_t count = size - i;
+            if (count > mask_bits_per_word)
+            {
+                count = mask_bits_per_word;
+            }
+            if (detail::pack_bits(f, i, count) != detail::low_bits(count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Return the number of i in [0, size) for which f(i) is true
+    template <typename F>
+    std::size_t mask_count(std::size_t size, F const& f)
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < size; i += mask_bits_per_word)
+        {
+            std::size_t count = size - i;
+            if (count > mask_bits_per_word)
+            {
+                count = mask_bits_per_word;
+            }
+            result += detail::popcount(detail::pack_bits(f, i, count));
+        }
+        return result;
+    }
+
+    /// Invoke g(i) for each i in [0, size) for which f(i) is true, in
+    /// increasing order of i
+    template <typename F, typename G>
+    void mask_for_each(std::size_t size, F const& f, G&& g)
+    {
+        for (std::size_t i = 0; i < size; i += mask_bits_per_word)
+        {
+            std::size_t count = size - i;
+            if (count > mask_bits_per_word)
+            {
+                count = mask_bits_per_word;
+            }
+
+            std::uint64_t word = detail::pack_bits(f, i, count);
+            while (word != 0)
+            {
+                g(i + detail::count_trailing_zeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+}}
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef PHYLANX_UTIL_DETAIL_BLAZE_SIMD_COMPARISON_OCT_19_2018_1000AM
+#define PHYLANX_UTIL_DETAIL_BLAZE_SIMD_COMPARISON_OCT_19_2018_1000AM
+
+#include <phylanx/util/detail/predicate_simd.hpp>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace util { namespace detail {
+    struct equal_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a == b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_eq(a, b);
+        }
+#endif
+    };
+
+    struct not_equal_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a != b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_ne(a, b);
+        }
+#endif
+    };
+
+    struct less_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a < b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_lt(a, b);
+        }
+#endif
+    };
+
+    struct less_equal_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a <= b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_le(a, b);
+        }
+#endif
+    };
+
+    struct greater_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a > b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_gt(a, b);
+        }
+#endif
+    };
+
+    struct greater_equal_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a >= b;
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::cmp_ge(a, b);
+        }
+#endif
+    };
+}}}
+#endif
@@ -0,0 +1,67 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef PHYLANX_UTIL_DETAIL_BLAZE_SIMD_LOGICAL_OCT_19_2018_1000AM
+#define PHYLANX_UTIL_DETAIL_BLAZE_SIMD_LOGICAL_OCT_19_2018_1000AM
+
+#include <phylanx/util/detail/predicate_simd.hpp>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace util { namespace detail {
+    struct and_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a != T1(0) && b != T2(0);
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::mask_and(simd::cmp_ne(a, simd::zero()),
+                simd::cmp_ne(b, simd::zero()));
+        }
+#endif
+    };
+
+    struct or_simd_op
+    {
+        template <typename T1, typename T2>
+        static BLAZE_ALWAYS_INLINE bool call(T1 const& a, T2 const& b)
+        {
+            return a != T1(0) || b != T2(0);
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a, simd::value_type b)
+        {
+            return simd::mask_or(simd::cmp_ne(a, simd::zero()),
+                simd::cmp_ne(b, simd::zero()));
+        }
+#endif
+    };
+
+    struct not_simd_op
+    {
+        template <typename T>
+        static BLAZE_ALWAYS_INLINE bool call(T const& a)
+        {
+            return a == T(0);
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        static BLAZE_ALWAYS_INLINE simd::mask_type simd_call(
+            simd::value_type a)
+        {
+            return simd::cmp_eq(a, simd::zero());
+        }
+#endif
+    };
+}}}
+#endif
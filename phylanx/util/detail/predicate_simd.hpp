@@ -0,0 +1,293 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef PHYLANX_UTIL_DETAIL_BLAZE_SIMD_PREDICATE_OCT_19_2018_1000AM
+#define PHYLANX_UTIL_DETAIL_BLAZE_SIMD_PREDICATE_OCT_19_2018_1000AM
+
+#include <type_traits>
+
+#include <blaze/Math.h>
+
+// Blaze does not provide vectorized comparisons, the intrinsics used below
+// cover the same instruction sets Blaze uses for double precision values.
+#if BLAZE_AVX512F_MODE && !BLAZE_MIC_MODE
+#define PHYLANX_HAVE_SIMD_PREDICATES
+#elif BLAZE_AVX_MODE && !BLAZE_MIC_MODE
+#define PHYLANX_HAVE_SIMD_PREDICATES
+#elif BLAZE_SSE2_MODE && !BLAZE_MIC_MODE
+#define PHYLANX_HAVE_SIMD_PREDICATES
+#endif
+
+namespace phylanx { namespace util { namespace detail {
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+    ///////////////////////////////////////////////////////////////////////////
+    // Comparisons of packs of doubles producing a mask, and conversion of a
+    // mask into a pack holding 1.0 for all set elements and 0.0 otherwise.
+    namespace simd
+    {
+#if BLAZE_AVX512F_MODE
+        using value_type = __m512d;
+        using mask_type = __mmask8;
+
+        BLAZE_ALWAYS_INLINE value_type zero()
+        {
+            return _mm512_setzero_pd();
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type cmp_eq(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ne(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_lt(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_le(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_gt(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ge(value_type a, value_type b)
+        {
+            return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type mask_and(mask_type a, mask_type b)
+        {
+            return mask_type(a & b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type mask_or(mask_type a, mask_type b)
+        {
+            return mask_type(a | b);
+        }
+
+        BLAZE_ALWAYS_INLINE value_type select_one(mask_type m)
+        {
+            return _mm512_maskz_mov_pd(m, _mm512_set1_pd(1.0));
+        }
+#elif BLAZE_AVX_MODE
+        using value_type = __m256d;
+        using mask_type = __m256d;
+
+        BLAZE_ALWAYS_INLINE value_type zero()
+        {
+            return _mm256_setzero_pd();
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type cmp_eq(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ne(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_lt(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_le(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_gt(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ge(value_type a, value_type b)
+        {
+            return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type mask_and(mask_type a, mask_type b)
+        {
+            return _mm256_and_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type mask_or(mask_type a, mask_type b)
+        {
+            return _mm256_or_pd(a, b);
+        }
+
+        BLAZE_ALWAYS_INLINE value_type select_one(mask_type m)
+        {
+            return _mm256_and_pd(m, _mm256_set1_pd(1.0));
+        }
+#else
+        using value_type = __m128d;
+        using mask_type = __m128d;
+
+        BLAZE_ALWAYS_INLINE value_type zero()
+        {
+            return _mm_setzero_pd();
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type cmp_eq(value_type a, value_type b)
+        {
+            return _mm_cmpeq_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ne(value_type a, value_type b)
+        {
+            return _mm_cmpneq_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_lt(value_type a, value_type b)
+        {
+            return _mm_cmplt_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_le(value_type a, value_type b)
+        {
+            return _mm_cmple_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_gt(value_type a, value_type b)
+        {
+            return _mm_cmpgt_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type cmp_ge(value_type a, value_type b)
+        {
+            return _mm_cmpge_pd(a, b);
+        }
+
+        BLAZE_ALWAYS_INLINE mask_type mask_and(mask_type a, mask_type b)
+        {
+            return _mm_and_pd(a, b);
+        }
+        BLAZE_ALWAYS_INLINE mask_type mask_or(mask_type a, mask_type b)
+        {
+            return _mm_or_pd(a, b);
+        }
+
+        BLAZE_ALWAYS_INLINE value_type select_one(mask_type m)
+        {
+            return _mm_and_pd(m, _mm_set1_pd(1.0));
+        }
+#endif
+    }
+#endif
+
+    // The SIMD code paths are available for double precision values only
+    template <typename T>
+    constexpr bool predicate_simd_enabled()
+    {
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        return std::is_same<T, double>::value;
+#else
+        return false;
+#endif
+    }
+
+    template <typename T1, typename T2>
+    constexpr bool predicate_simd_enabled()
+    {
+        return predicate_simd_enabled<T1>() && predicate_simd_enabled<T2>();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The functor below evaluates a predicate (see comparison_simd.hpp and
+    // logical_simd.hpp) and produces 1 or 0 using the element type of the
+    // operands. This allows for the results to be stored in place and for
+    // Blaze to use the vectorized kernels.
+
+    // predicate(a, scalar), used for scalars on either side as the
+    // comparisons evaluate Op(element, scalar) in both cases
+    template <typename Pred, typename S>
+    struct predicatend0d_simd
+    {
+    public:
+        explicit predicatend0d_simd(S scalar)
+          : scalar_(scalar)
+        {
+        }
+
+        template <typename T>
+        BLAZE_ALWAYS_INLINE T operator()(T const& a) const
+        {
+            return Pred::call(a, scalar_) ? T(1) : T(0);
+        }
+
+        template <typename T>
+        static constexpr bool simdEnabled()
+        {
+            return predicate_simd_enabled<T, S>();
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        template <typename T>
+        BLAZE_ALWAYS_INLINE decltype(auto) load(T const& a) const
+        {
+            BLAZE_CONSTRAINT_MUST_BE_SIMD_PACK(T);
+            return T(simd::select_one(
+                Pred::simd_call(a.value, blaze::set(scalar_).value)));
+        }
+#endif
+
+    private:
+        S scalar_;
+    };
+
+    // predicate(a, b), used for elementwise operations and for broadcasting
+    // a vector over the rows of a matrix
+    template <typename Pred>
+    struct predicatendnd_simd
+    {
+    public:
+        template <typename T>
+        BLAZE_ALWAYS_INLINE T operator()(T const& a, T const& b) const
+        {
+            return Pred::call(a, b) ? T(1) : T(0);
+        }
+
+        template <typename T1, typename T2>
+        static constexpr bool simdEnabled()
+        {
+            return predicate_simd_enabled<T1, T2>();
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        template <typename T1, typename T2>
+        BLAZE_ALWAYS_INLINE decltype(auto) load(
+            T1 const& a, T2 const& b) const
+        {
+            BLAZE_CONSTRAINT_MUST_BE_SIMD_PACK(T1);
+            BLAZE_CONSTRAINT_MUST_BE_SIMD_PACK(T2);
+            return T1(simd::select_one(Pred::simd_call(a.value, b.value)));
+        }
+#endif
+    };
+
+    // predicate(a) for unary predicates
+    template <typename Pred>
+    struct predicate_simd
+    {
+    public:
+        template <typename T>
+        BLAZE_ALWAYS_INLINE T operator()(T const& a) const
+        {
+            return Pred::call(a) ? T(1) : T(0);
+        }
+
+        template <typename T>
+        static constexpr bool simdEnabled()
+        {
+            return predicate_simd_enabled<T>();
+        }
+
+#if defined(PHYLANX_HAVE_SIMD_PREDICATES)
+        template <typename T>
+        BLAZE_ALWAYS_INLINE decltype(auto) load(T const& a) const
+        {
+            BLAZE_CONSTRAINT_MUST_BE_SIMD_PACK(T);
+            return T(simd::select_one(Pred::simd_call(a.value)));
+        }
+#endif
+    };
+}}}
+#endif
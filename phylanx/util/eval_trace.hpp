@@ -0,0 +1,90 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_EVAL_TRACE_HPP)
+#define PHYLANX_UTIL_EVAL_TRACE_HPP
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    /// A single evaluation of a primitive as captured by the timeline
+    /// recorder.
+    struct eval_trace_event
+    {
+        /// Shape of a value: number of dimensions followed by the extents.
+        /// The number of dimensions is -1 for non-numeric values.
+        using shape_type = std::array<std::int64_t, 3>;
+
+        /// maximal number of argument shapes captured per event
+        static constexpr std::size_t max_args = 2;
+
+        char const* name_;          // interned name of the primitive
+        std::uint64_t begin_;       // timestamps in [ns]
+        std::uint64_t end_;
+        std::size_t worker_thread_; // worker thread that started the eval
+        std::uint32_t locality_;
+        std::uint32_t num_args_;    // number of arguments passed to eval
+        std::array<shape_type, max_args> arg_shapes_;
+        shape_type result_shape_;
+    };
+
+    /// Enable or disable the recording of primitive evaluations.
+    ///
+    /// \param enable      Turn recording on or off
+    /// \param buffer_size Number of events kept in the ring buffer, older
+    ///                    events are overwritten once it is full. A value of
+    ///                    zero keeps the current size (the initial size can be
+    ///                    set using the configuration entry
+    ///                    'phylanx.eval_trace_buffer_size').
+    ///
+    /// \returns Whether recording was enabled before this call
+    ///
+    /// \note Recording can be enabled at startup by setting the configuration
+    ///       entry 'phylanx.eval_trace' to the name of a file, the recorded
+    ///       timeline is written to that file at shutdown.
+    ///
+    PHYLANX_EXPORT bool enable_eval_trace(
+        bool enable = true, std::size_t buffer_size = 0);
+
+    /// Return whether the evaluation of primitives is currently recorded.
+    PHYLANX_EXPORT bool eval_trace_enabled();
+
+    /// Return a pointer to a string with the same contents as the given name
+    /// which remains valid for the lifetime of the application.
+    PHYLANX_EXPORT char const* eval_trace_intern(std::string const& name);
+
+    /// Store the given event in the ring buffer.
+    PHYLANX_EXPORT void record_eval_trace(eval_trace_event const& event);
+
+    /// Retrieve the recorded events (oldest first).
+    ///
+    /// \param reset Discard the recorded events after retrieving them
+    ///
+    /// \note Recording is suspended while the events are retrieved, events
+    ///       of evaluations finishing in the meantime are dropped.
+    ///
+    PHYLANX_EXPORT std::vector<eval_trace_event> retrieve_eval_trace(
+        bool reset = false);
+
+    /// Write the given events using the Chrome trace-event JSON format (as
+    /// understood by chrome://tracing, Perfetto, or speedscope).
+    PHYLANX_EXPORT void write_chrome_trace(std::ostream& os,
+        std::vector<eval_trace_event> const& events);
+
+    /// Write the currently recorded events using the Chrome trace-event JSON
+    /// format to the given file.
+    PHYLANX_EXPORT void write_chrome_trace(std::string const& filename,
+        bool reset = false);
+}}
+
+#endif
@@ -9,11 +9,13 @@
 
 #include <phylanx/config.hpp>
 
+#include <hpx/lcos/future.hpp>
 #include <hpx/runtime/find_here.hpp>
 
 #include <cstdint>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace phylanx { namespace util
@@ -23,6 +25,9 @@ namespace phylanx { namespace util
     ///
     /// \param primitive_instances The primitives for which performance counter
     ///                 data is required
+    /// \param size_histogram Additionally bucket the eval count and duration
+    ///                 by the number of elements involved (see
+    ///                 retrieve_size_histogram)
     ///
     /// \note This has to be called after compilation of a PhySL code block and
     ///       before its execution.
@@ -31,17 +36,23 @@ namespace phylanx { namespace util
     ///          data was enabled
     ///
     PHYLANX_EXPORT std::vector<std::string> enable_measurements(
-        std::map<std::string, hpx::id_type> const& primitive_instances);
+        std::map<std::string, hpx::id_type> const& primitive_instances,
+        bool size_histogram = false);
 
     /// Enable the collection of performance data for all existing primitives.
     ///
+    /// \param size_histogram Additionally bucket the eval count and duration
+    ///                 by the number of elements involved (see
+    ///                 retrieve_size_histogram)
+    ///
     /// \note This has to be called after compilation of a PhySL code block and
     ///       before its execution.
     ///
     /// \returns The list of primitives for which the collection of performance
     ///          data was enabled
     ///
-    PHYLANX_EXPORT std::vector<std::string> enable_measurements();
+    PHYLANX_EXPORT std::vector<std::string> enable_measurements(
+        bool size_histogram = false);
 
     /// Retrieve specified performance counter data for the selected primitives
     ///
@@ -50,6 +61,9 @@ namespace phylanx { namespace util
     /// \param counter_name_last_parts A vector containing the last part of the
     ///                 performance counter names. e.g. std::vector{
     ///                     "count/eval", "time/eval", "eval_direct" }
+    ///                 The memory accounting counters "memory/allocated",
+    ///                 "memory/largest_result", and "count/copies" are
+    ///                 available as well.
     /// \param locality_id The locality the performance counter data is going
     ///                 to be queried from
     ///
@@ -97,5 +111,78 @@ namespace phylanx { namespace util
     ///
     PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
     retrieve_counter_data(hpx::id_type const& locality_id = hpx::find_here());
+
+    /// Performance counter data collected from all localities
+    struct counter_data_summary
+    {
+        /// The last parts of the names of the counters, the values below are
+        /// given in this order
+        std::vector<std::string> counter_names;
+
+        /// The counter values for each primitive instance (name)
+        std::map<std::string, std::vector<std::int64_t>> instances;
+
+        /// The counter values accumulated for each primitive type (e.g.
+        /// "__add", "dot") over all instances on all localities
+        std::map<std::string, std::vector<std::int64_t>> primitives;
+
+        /// The counter values accumulated over all primitive instances
+        /// living on a locality, for each locality
+        std::map<std::uint32_t, std::vector<std::int64_t>> localities;
+
+        /// For each counter, the ratio of the largest per-locality value to
+        /// the average per-locality value (1.0 if perfectly balanced)
+        std::vector<double> load_imbalance;
+    };
+
+    /// Retrieve specified performance counter data for all primitives from
+    /// all localities. The localities are queried concurrently.
+    ///
+    /// \param counter_name_last_parts A vector containing the last part of the
+    ///                 performance counter names (see retrieve_counter_data)
+    ///
+    /// \return a future referring to the collected data
+    ///
+    /// \exception hpx::exception
+    ///
+    PHYLANX_EXPORT hpx::future<counter_data_summary> retrieve_all_counter_data(
+        std::vector<std::string> const& counter_name_last_parts);
+
+    /// Retrieve the counters "count/eval", "time/eval", and "eval_direct"
+    /// for all primitives from all localities, see above.
+    PHYLANX_EXPORT hpx::future<counter_data_summary>
+    retrieve_all_counter_data();
+
+    /// Retrieve the eval count and duration of the selected primitives
+    /// bucketed by size class. Size class k holds the evaluations for which
+    /// the largest argument or the result had [2^k, 2^(k+1)) elements (size
+    /// class zero holds scalars and empty values). The same data is exposed
+    /// by the performance counter instances
+    /// /phylanx{locality#<N>/size_class#<k>}/primitives/<name>/count/eval
+    /// and .../time/eval.
+    ///
+    /// \param primitive_instances The (local) primitives for which the data
+    ///                 is required
+    /// \param reset    Reset the collected data after retrieving it
+    ///
+    /// \return a std::map containing key/value pairs of primitive instances
+    ///         (names)/list of (eval count, eval duration [ns]) pairs, one
+    ///         for each size class. Primitives for which no data was
+    ///         collected are omitted.
+    ///
+    /// \note The data is collected only for primitives for which
+    ///       enable_measurements(true) was called.
+    ///
+    PHYLANX_EXPORT std::map<std::string,
+        std::vector<std::pair<std::int64_t, std::int64_t>>>
+    retrieve_size_histogram(
+        std::map<std::string, hpx::id_type> const& primitive_instances,
+        bool reset = false);
+
+    /// Retrieve the eval count and duration bucketed by size class for all
+    /// existing (local) primitives, see above.
+    PHYLANX_EXPORT std::map<std::string,
+        std::vector<std::pair<std::int64_t, std::int64_t>>>
+    retrieve_size_histogram(bool reset = false);
 }}
 #endif
@@ -14,10 +14,77 @@
 
 #include <blaze/Math.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <vector>
 
 namespace hpx { namespace serialization
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // The elements of Blaze vectors and matrices are sent as a single array,
+    // which HPX turns into a zero-copy chunk referring to the (aligned)
+    // buffer of the object if the array is large enough (see
+    // hpx.parcel.zero_copy_serialization_threshold). Matrices are sent
+    // including the padding of each row (column), except for the last one.
+    // The padding on the receiving end may differ from the padding used by
+    // the sender, in which case the data is rearranged after receiving it.
+    namespace detail
+    {
+        // number of elements covered by 'outer' rows (columns) of 'inner'
+        // elements, where consecutive rows (columns) are 'spacing' apart
+        inline std::size_t padded_span(
+            std::size_t outer, std::size_t inner, std::size_t spacing)
+        {
+            return outer == 0 ? 0 : (outer - 1) * spacing + inner;
+        }
+
+        template <typename T>
+        void save_padded(output_archive& archive, T const* data,
+            std::size_t outer, std::size_t inner, std::size_t spacing)
+        {
+            archive << spacing;
+            archive << hpx::serialization::make_array(
+                data, padded_span(outer, inner, spacing));
+        }
+
+        template <typename T>
+        void load_padded(input_archive& archive, T* data, std::size_t outer,
+            std::size_t inner, std::size_t target_spacing)
+        {
+            std::size_t spacing = 0UL;
+            archive >> spacing;
+
+            std::size_t span = padded_span(outer, inner, spacing);
+            if (spacing == target_spacing)
+            {
+                archive >> hpx::serialization::make_array(data, span);
+
+                // Blaze requires the padding elements to be zero, don't
+                // rely on the sender having kept them that way (the
+                // padding of the last row (column) is not received)
+                if (spacing != inner)
+                {
+                    for (std::size_t i = 0; i + 1 < outer; ++i)
+                    {
+                        std::fill(data + i * spacing + inner,
+                            data + (i + 1) * spacing, T());
+                    }
+                }
+                return;
+            }
+
+            // the padding used by the sender differs from ours
+            std::vector<T> buffer(span);
+            archive >> hpx::serialization::make_array(buffer.data(), span);
+
+            for (std::size_t i = 0; i != outer; ++i)
+            {
+                std::copy_n(buffer.data() + i * spacing, inner,
+                    data + i * target_spacing);
+            }
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, bool TF>
     void load(
@@ -25,12 +92,10 @@ namespace hpx { namespace serialization
     {
         // De-serialize vector
         std::size_t count = 0UL;
-        std::size_t spacing = 0UL;
-        archive >> count >> spacing;
+        archive >> count;
 
         target.resize(count, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), spacing);
+        archive >> hpx::serialization::make_array(target.data(), count);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -41,12 +106,11 @@ namespace hpx { namespace serialization
         // De-serialize matrix
         std::size_t rows = 0UL;
         std::size_t columns = 0UL;
-        std::size_t spacing = 0UL;
-        archive >> rows >> columns >> spacing;
+        archive >> rows >> columns;
 
         target.resize(rows, columns, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), spacing * columns);
+        detail::load_padded(
+            archive, target.data(), columns, rows, target.spacing());
     }
 
     template <typename T>
@@ -56,12 +120,11 @@ namespace hpx { namespace serialization
         // De-serialize matrix
         std::size_t rows = 0UL;
         std::size_t columns = 0UL;
-        std::size_t spacing = 0UL;
-        archive >> rows >> columns >> spacing;
+        archive >> rows >> columns;
 
         target.resize(rows, columns, false);
-        archive >>
-            hpx::serialization::make_array(target.data(), rows * spacing);
+        detail::load_padded(
+            archive, target.data(), rows, columns, target.spacing());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -86,9 +149,8 @@ namespace hpx { namespace serialization
     {
         // Serialize vector
         std::size_t count = target.size();
-        std::size_t spacing = target.spacing();
-        archive << count << spacing;
-        archive << hpx::serialization::make_array(target.data(), spacing);
+        archive << count;
+        archive << hpx::serialization::make_array(target.data(), count);
     }
 
     template <typename T>
@@ -98,10 +160,9 @@ namespace hpx { namespace serialization
         // Serialize matrix
         std::size_t rows = target.rows();
         std::size_t columns = target.columns();
-        std::size_t spacing = target.spacing();
-        archive << rows << columns << spacing;
-        archive << hpx::serialization::make_array(
-            target.data(), spacing * columns);
+        archive << rows << columns;
+        detail::save_padded(
+            archive, target.data(), columns, rows, target.spacing());
     }
 
     template <typename T>
@@ -111,22 +172,21 @@ namespace hpx { namespace serialization
         // Serialize matrix
         std::size_t rows = target.rows();
         std::size_t columns = target.columns();
-        std::size_t spacing = target.spacing();
-        archive << rows << columns << spacing;
-        archive << hpx::serialization::make_array(
-            target.data(), rows * spacing);
+        archive << rows << columns;
+        detail::save_padded(
+            archive, target.data(), rows, columns, target.spacing());
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    // Custom vectors and matrices are de-serialized as dynamic ones
     template <typename T, bool AF, bool PF, bool TF>
     void save(output_archive& archive,
         blaze::CustomVector<T, AF, PF, TF> const& target, unsigned)
     {
         // Serialize vector
         std::size_t count = target.size();
-        std::size_t spacing = target.spacing();
-        archive << count << spacing;
-        archive << hpx::serialization::make_array(target.data(), spacing);
+        archive << count;
+        archive << hpx::serialization::make_array(target.data(), count);
     }
 
     template <typename T, bool AF, bool PF>
@@ -136,10 +196,9 @@ namespace hpx { namespace serialization
         // Serialize matrix
         std::size_t rows = target.rows();
         std::size_t columns = target.columns();
-        std::size_t spacing = target.spacing();
-        archive << rows << columns << spacing;
-        archive << hpx::serialization::make_array(
-            target.data(), spacing * columns);
+        archive << rows << columns;
+        detail::save_padded(
+            archive, target.data(), columns, rows, target.spacing());
     }
 
     template <typename T, bool AF, bool PF>
@@ -149,10 +208,9 @@ namespace hpx { namespace serialization
         // Serialize matrix
         std::size_t rows = target.rows();
         std::size_t columns = target.columns();
-        std::size_t spacing = target.spacing();
-        archive << rows << columns << spacing;
-        archive << hpx::serialization::make_array(
-            target.data(), rows * spacing);
+        archive << rows << columns;
+        detail::save_padded(
+            archive, target.data(), rows, columns, target.spacing());
     }
 
     ///////////////////////////////////////////////////////////////////////////
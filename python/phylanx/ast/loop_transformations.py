@@ -0,0 +1,592 @@
+# Copyright (c) 2018 R. Tohid
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+'''
+Loop transformations on the Python AST.
+
+Affine loop nests (the loops the OpenSCoP backend describes) are analyzed for
+data dependencies. If all loops of a perfectly nested band are permutable,
+the loops are interchanged such that the innermost loop walks along the rows
+of the accessed (row-major) arrays and the band is tiled (cache blocked).
+
+    for i in range(N):
+        for j in range(N):
+            for k in range(N):
+                C[i, j] += A[i, k] * B[k, j]
+
+becomes (with the tile size T)
+
+    for i_tile in range(0, N, T):
+        for k_tile in range(0, N, T):
+            for j_tile in range(0, N, T):
+                for i in range(i_tile, i_tile + T):
+                    if i < N:
+                        for k in range(k_tile, k_tile + T):
+                            if k < N:
+                                for j in range(j_tile, j_tile + T):
+                                    if j < N:
+                                        C[i, j] += A[i, k] * B[k, j]
+
+Loops whose iterations compute array elements independently of each other
+are replaced with whole array operations (executed by a single primitive):
+
+    for i in range(1, N):
+        z[i] = x[i] + y[i - 1]
+
+becomes
+
+    z[1:N] = x[1:N] + y[0:N - 1]
+'''
+
+import ast
+import copy
+
+default_tile_size = 32
+
+
+class AffineExpr:
+    """Affine expression: `sum(coefs[v] * v) + const`."""
+
+    def __init__(self, coefs=None, const=0):
+        self.coefs = {k: v for k, v in (coefs or {}).items() if v != 0}
+        self.const = const
+
+    def __add__(self, rhs):
+        coefs = dict(self.coefs)
+        for k, v in rhs.coefs.items():
+            coefs[k] = coefs.get(k, 0) + v
+        return AffineExpr(coefs, self.const + rhs.const)
+
+    def scale(self, factor):
+        coefs = {k: v * factor for k, v in self.coefs.items()}
+        return AffineExpr(coefs, self.const * factor)
+
+    def is_constant(self):
+        return not self.coefs
+
+
+def affine_expr(node):
+    """Returns the `AffineExpr` for the given AST node or `None` if the
+    expression is not affine."""
+
+    if isinstance(node, ast.Name):
+        return AffineExpr({node.id: 1})
+    if isinstance(node, ast.Num) and isinstance(node.n, int):
+        return AffineExpr(const=node.n)
+    if isinstance(node, ast.Index):
+        return affine_expr(node.value)
+    if isinstance(node, ast.Call):
+        # loop bounds like `shape(a, 0)` are treated as symbolic parameters
+        return AffineExpr({ast.dump(node): 1})
+    if isinstance(node, ast.UnaryOp) and isinstance(node.op, ast.USub):
+        operand = affine_expr(node.operand)
+        return operand.scale(-1) if operand is not None else None
+    if isinstance(node, ast.BinOp):
+        left = affine_expr(node.left)
+        right = affine_expr(node.right)
+        if left is None or right is None:
+            return None
+        if isinstance(node.op, ast.Add):
+            return left + right
+        if isinstance(node.op, ast.Sub):
+            return left + right.scale(-1)
+        if isinstance(node.op, ast.Mult):
+            if left.is_constant():
+                return right.scale(left.const)
+            if right.is_constant():
+                return left.scale(right.const)
+    return None
+
+
+###############################################################################
+class Loop:
+    """A loop `for var in range(lower, upper)` of an affine loop nest."""
+
+    def __init__(self, node, var, lower, upper):
+        self.node = node
+        self.var = var
+        self.lower = lower
+        self.upper = upper
+
+
+def as_affine_loop(node):
+    """Returns a `Loop` if `node` is a unit-stride `range` loop, `None`
+    otherwise."""
+
+    if not isinstance(node, ast.For) or node.orelse or \
+            not isinstance(node.target, ast.Name):
+        return None
+    it = node.iter
+    if not isinstance(it, ast.Call) or not isinstance(it.func, ast.Name) or \
+            it.func.id != 'range' or it.keywords or \
+            not 1 <= len(it.args) <= 2:
+        return None
+    if len(it.args) == 1:
+        lower, upper = ast.Num(n=0), it.args[0]
+    else:
+        lower, upper = it.args
+    if affine_expr(lower) is None or affine_expr(upper) is None:
+        return None
+    return Loop(node, node.target.id, lower, upper)
+
+
+def perfect_loop_nest(node):
+    """Returns the loops of the perfectly nested band starting at `node` and
+    the statements of the innermost loop body."""
+
+    loops = []
+    loop = as_affine_loop(node)
+    while loop is not None:
+        loops.append(loop)
+        body = loop.node.body
+        if len(body) != 1:
+            break
+        loop = as_affine_loop(body[0])
+
+    if not loops:
+        return [], None
+
+    # only rectangular nests are supported: the bounds may not depend on
+    # the loop variables of the band. The bounds are evaluated more than once
+    # after tiling, thus they are assumed to be free of side effects.
+    loop_vars = {l.var for l in loops}
+    for l in loops:
+        for bound in (l.lower, l.upper):
+            if any(isinstance(n, ast.Name) and n.id in loop_vars
+                   for n in ast.walk(bound)):
+                return [], None
+
+    return loops, loops[-1].node.body
+
+
+###############################################################################
+class Access:
+    """An array access `name[subscripts]` of a statement."""
+
+    def __init__(self, name, subscripts, write, statement):
+        self.name = name
+        self.subscripts = subscripts
+        self.write = write
+        self.statement = statement
+
+
+def subscripts_of(node):
+    """Returns the (array name, list of index nodes) of a subscript,
+    `a[i][j]` and `a[i, j]` are treated alike."""
+
+    indices = []
+    while isinstance(node, ast.Subscript):
+        index = node.slice
+        if isinstance(index, ast.Index):
+            index = index.value
+        if isinstance(index, ast.Tuple):
+            indices = list(index.elts) + indices
+        else:
+            indices.insert(0, index)
+        node = node.value
+    if not isinstance(node, ast.Name):
+        return None, None
+    return node.id, indices
+
+
+def outermost_subscripts(node):
+    """Yields the subscripts of an expression, the subscripts nested in
+    `a[i][j]` are not reported separately."""
+
+    if isinstance(node, ast.Subscript):
+        yield node
+        return
+    for child in ast.iter_child_nodes(node):
+        for subscript in outermost_subscripts(child):
+            yield subscript
+
+
+def array_accesses(body, loop_vars):
+    """Returns all array accesses of the loop body or `None` if the body
+    contains anything which is not analyzable."""
+
+    accesses = []
+    for stmt in body:
+        if isinstance(stmt, ast.AugAssign):
+            target, reads = stmt.target, [stmt.target, stmt.value]
+        elif isinstance(stmt, ast.Assign) and len(stmt.targets) == 1:
+            target, reads = stmt.targets[0], [stmt.value]
+        else:
+            return None
+
+        # scalar assignments carry dependencies
+        if not isinstance(target, ast.Subscript):
+            return None
+
+        # calls may have side effects
+        if any(isinstance(n, (ast.Call, ast.Lambda)) for n in ast.walk(stmt)):
+            return None
+
+        for node, write in [(target, True)] + [(r, False) for r in reads]:
+            for subscript in outermost_subscripts(node):
+                name, indices = subscripts_of(subscript)
+                if name is None or name in loop_vars:
+                    return None
+                subscripts = [affine_expr(i) for i in indices]
+                if any(s is None for s in subscripts):
+                    return None
+                accesses.append(Access(name, subscripts, write, stmt))
+    return accesses
+
+
+def dependence_distance(source, sink, loop_vars):
+    """Returns the dependence distance vector between two accesses to the
+    same array (`None` for unknown/non-uniform dependencies, `False` if the
+    accesses never overlap). Components not constrained by the subscripts
+    are returned as `'*'`."""
+
+    if len(source.subscripts) != len(sink.subscripts):
+        return None
+
+    distance = {}
+    for s, t in zip(source.subscripts, sink.subscripts):
+        if s.coefs != t.coefs:
+            return None
+        used = [v for v in s.coefs if v in loop_vars]
+        if len(used) > 1:
+            return None
+        if not used:
+            if s.const != t.const:
+                return False
+            continue
+        var = used[0]
+        delta = s.const - t.const
+        if delta % s.coefs[var] != 0:
+            return False
+        d = delta // s.coefs[var]
+        if distance.setdefault(var, d) != d:
+            return False
+
+    return [distance.get(v, '*') for v in loop_vars]
+
+
+def is_permutable(loops, body):
+    """Whether the loops of the band can be freely interchanged and tiled,
+    i.e. all dependence distances are non-negative in every dimension."""
+
+    loop_vars = [l.var for l in loops]
+    accesses = array_accesses(body, set(loop_vars))
+    if accesses is None:
+        return False
+
+    for a in accesses:
+        for b in accesses:
+            if a.name != b.name or not (a.write or b.write):
+                continue
+            distance = dependence_distance(a, b, loop_vars)
+            if distance is False:
+                continue
+            if distance is None:
+                return False
+            known = [d for d in distance if d != '*']
+            if '*' in distance:
+                # any distance along the unconstrained loops, this is fine
+                # only if all other components are zero (e.g. reductions)
+                if any(known):
+                    return False
+            elif any(d < 0 for d in known) and any(d > 0 for d in known):
+                # the dependence is carried into opposite directions
+                return False
+    return True
+
+
+def preferred_order(loops, body):
+    """Returns the loops ordered such that the innermost loop varies the
+    last subscript of as many accesses as possible (unit stride for row-major
+    arrays). The relative order of the other loops is preserved."""
+
+    loop_vars = [l.var for l in loops]
+    accesses = array_accesses(body, set(loop_vars)) or []
+
+    def stride_one_accesses(var):
+        count = 0
+        for a in accesses:
+            if a.subscripts and a.subscripts[-1].coefs.get(var) == 1 and \
+                    not any(var in s.coefs for s in a.subscripts[:-1]):
+                count += 1
+        return count
+
+    innermost = max(reversed(loops), key=lambda l: stride_one_accesses(l.var))
+    return [l for l in loops if l is not innermost] + [innermost]
+
+
+###############################################################################
+def unique_name(name, used):
+    while name in used:
+        name += '_'
+    used.add(name)
+    return name
+
+
+class SubstituteNames(ast.NodeTransformer):
+    def __init__(self, names):
+        self.names = names
+
+    def visit_Name(self, node):
+        if node.id in self.names:
+            return copy.deepcopy(self.names[node.id])
+        return node
+
+
+def tile_loop_nest(loops, body, tile_size, used_names):
+    """Returns the tiled loop nest as a single `For` node."""
+
+    names = {}
+    tiles = []
+    for n, l in enumerate(loops):
+        tile = unique_name(l.var + '_tile', used_names)
+        tiles.append(tile)
+        names['__lower%d' % n] = l.lower
+        names['__upper%d' % n] = l.upper
+
+    # generate the source of the loop nest, the bounds and the body are
+    # substituted afterwards
+    src = ''
+    indent = ''
+    for n, l in enumerate(loops):
+        src += '%sfor %s in range(__lower%d, __upper%d, %d):\n' % (
+            indent, tiles[n], n, n, tile_size)
+        indent += '    '
+    for n, l in enumerate(loops):
+        src += '%sfor %s in range(%s, %s + %d):\n' % (
+            indent, l.var, tiles[n], tiles[n], tile_size)
+        indent += '    '
+        src += '%sif %s < __upper%d:\n' % (indent, l.var, n)
+        indent += '    '
+    src += '%spass\n' % indent
+
+    nest = SubstituteNames(names).visit(ast.parse(src).body[0])
+
+    # attach the original loop body
+    innermost = nest
+    while not isinstance(innermost.body[0], ast.Pass):
+        innermost = innermost.body[0]
+    innermost.body = body
+
+    # generated nodes refer to the location of the outermost original loop
+    original = {id(m) for b in body for m in ast.walk(b)}
+    for n in ast.walk(nest):
+        if hasattr(n, 'lineno') and id(n) not in original:
+            ast.copy_location(n, loops[0].node)
+    return nest
+
+
+class LoopTiling(ast.NodeTransformer):
+    """Interchange and tile all permutable affine loop nests."""
+
+    def __init__(self, tile_size, used_names):
+        self.tile_size = tile_size
+        self.used_names = used_names
+
+    def visit_For(self, node):
+        loops, body = perfect_loop_nest(node)
+        if len(loops) < 2 or not is_permutable(loops, body):
+            return self.generic_visit(node)
+
+        loops = preferred_order(loops, body)
+        return tile_loop_nest(loops, body, self.tile_size, self.used_names)
+
+
+def tile_loops(tree, tile_size=default_tile_size):
+    """Interchange and tile all permutable affine loop nests of the given
+    Python AST (modified in place)."""
+
+    if not isinstance(tile_size, int) or tile_size < 1:
+        raise ValueError("tile_loops: the tile size must be a positive "
+                         "integer, got: %r" % (tile_size, ))
+
+    used_names = {n.id for n in ast.walk(tree) if isinstance(n, ast.Name)}
+    tree = LoopTiling(tile_size, used_names).visit(tree)
+    return ast.fix_missing_locations(tree)
+
+
+###############################################################################
+# functions which are applied elementwise to arrays
+elementwise_functions = {
+    'absolute', 'arccos', 'arcsin', 'arctan', 'ceil', 'cos', 'cosh', 'exp',
+    'floor', 'log', 'log10', 'log2', 'power', 'rint', 'sin', 'sinh', 'sqrt',
+    'tan', 'tanh', 'trunc'
+}
+
+
+def elementwise_offset(node, var):
+    """Returns `c` if `node` is the subscript `a[var + c]` of a
+    one-dimensional access, `None` otherwise."""
+
+    name, indices = subscripts_of(node)
+    if name is None or len(indices) != 1:
+        return None
+    index = affine_expr(indices[0])
+    if index is None or index.coefs != {var: 1}:
+        return None
+    return index.const
+
+
+class Vectorize(ast.NodeTransformer):
+    """Replaces the subscripts `a[var + c]` of an elementwise expression with
+    the slices `a[lower + c:upper + c]`."""
+
+    def __init__(self, var, lower, upper):
+        self.var = var
+        self.lower = lower
+        self.upper = upper
+
+    def bound(self, bound, offset):
+        if isinstance(bound, ast.Num):
+            return ast.Num(n=bound.n + offset)
+        bound = copy.deepcopy(bound)
+        if isinstance(bound, ast.BinOp) and \
+                isinstance(bound.op, (ast.Add, ast.Sub)) and \
+                isinstance(bound.right, ast.Num):
+            # fold `upper - 1 + 1` into `upper`
+            if isinstance(bound.op, ast.Sub):
+                offset -= bound.right.n
+            else:
+                offset += bound.right.n
+            bound = bound.left
+        if offset == 0:
+            return bound
+        op = ast.Add() if offset > 0 else ast.Sub()
+        return ast.BinOp(left=bound, op=op, right=ast.Num(n=abs(offset)))
+
+    def visit_Subscript(self, node):
+        offset = elementwise_offset(node, self.var)
+        index = ast.Slice(
+            lower=self.bound(self.lower, offset),
+            upper=self.bound(self.upper, offset),
+            step=None)
+        return ast.copy_location(
+            ast.Subscript(value=node.value, slice=index, ctx=node.ctx), node)
+
+
+def elementwise_statements(loop):
+    """Returns the loop body as a list of `(target, value)` pairs if all
+    statements of the loop are elementwise assignments which can be executed
+    as whole array operations, `None` otherwise."""
+
+    var = loop.var
+    statements = []
+    for stmt in loop.node.body:
+        if isinstance(stmt, ast.Assign) and len(stmt.targets) == 1:
+            target, value = stmt.targets[0], stmt.value
+        elif isinstance(stmt, ast.AugAssign):
+            target = stmt.target
+            load = ast.Subscript(
+                value=target.value, slice=target.slice, ctx=ast.Load())
+            value = ast.BinOp(left=load, op=stmt.op, right=stmt.value)
+        else:
+            return None
+
+        if not isinstance(target, ast.Subscript) or \
+                elementwise_offset(target, var) is None:
+            return None
+        if not is_elementwise(value, var):
+            return None
+        statements.append((target, value))
+    return statements
+
+
+def is_elementwise(node, var):
+    """Whether `node` computes its elements independently of each other,
+    all subscripts have to be of the form `a[var + c]`."""
+
+    if isinstance(node, ast.Subscript):
+        return elementwise_offset(node, var) is not None
+    if isinstance(node, ast.Name):
+        return node.id != var
+    if isinstance(node, ast.Num):
+        return True
+    if isinstance(node, ast.BinOp):
+        return isinstance(node.op, (ast.Add, ast.Sub, ast.Mult, ast.Div)) \
+            and is_elementwise(node.left, var) \
+            and is_elementwise(node.right, var)
+    if isinstance(node, ast.UnaryOp):
+        return isinstance(node.op, ast.USub) and \
+            is_elementwise(node.operand, var)
+    if isinstance(node, ast.Call):
+        func = node.func
+        if isinstance(func, ast.Attribute) and \
+                isinstance(func.value, ast.Name):
+            name = func.attr
+        elif isinstance(func, ast.Name):
+            name = func.id
+        else:
+            return False
+        return name in elementwise_functions and not node.keywords and \
+            all(is_elementwise(arg, var) for arg in node.args)
+    return False
+
+
+def is_vectorizable(loop, statements):
+    """Whether executing the statements one after the other on whole arrays
+    yields the same results as executing the loop."""
+
+    var = loop.var
+    lower = affine_expr(loop.lower)
+
+    def wraps_around(offset):
+        # negative indices would refer to the end of the array
+        return offset < 0 and \
+            (not lower.is_constant() or lower.const + offset < 0)
+
+    writes = {}
+    for n, (target, _) in enumerate(statements):
+        name, _ = subscripts_of(target)
+        offset = elementwise_offset(target, var)
+        if wraps_around(offset):
+            return False
+        if writes.setdefault(name, (n, offset))[1] != offset:
+            return False        # output dependency between the iterations
+
+    for n, (target, value) in enumerate(statements):
+        for subscript in outermost_subscripts(value):
+            name, _ = subscripts_of(subscript)
+            offset = elementwise_offset(subscript, var)
+            if wraps_around(offset):
+                return False
+            if name not in writes:
+                continue
+            written, write_offset = writes[name]
+            if written < n and offset != write_offset:
+                return False    # reads a value written by another iteration
+            if written >= n and offset < write_offset:
+                return False    # reads a value written by an earlier iteration
+    return True
+
+
+class LoopVectorization(ast.NodeTransformer):
+    """Replace elementwise loops with whole array operations."""
+
+    def visit_For(self, node):
+        loop = as_affine_loop(node)
+        if loop is None or any(isinstance(n, ast.Name) and n.id == loop.var
+                               for b in (loop.lower, loop.upper)
+                               for n in ast.walk(b)):
+            return self.generic_visit(node)
+
+        statements = elementwise_statements(loop)
+        if not statements or not is_vectorizable(loop, statements):
+            return self.generic_visit(node)
+
+        vectorize = Vectorize(loop.var, loop.lower, loop.upper)
+        result = []
+        for target, value in statements:
+            assign = ast.Assign(
+                targets=[vectorize.visit(copy.deepcopy(target))],
+                value=vectorize.visit(copy.deepcopy(value)))
+            result.append(ast.copy_location(assign, target))
+        return result
+
+
+def vectorize_loops(tree):
+    """Replace all elementwise loops of the given Python AST with whole array
+    operations (modified in place)."""
+
+    tree = LoopVectorization().visit(tree)
+    return ast.fix_missing_locations(tree)
@@ -14,7 +14,7 @@ from .utils import dump_ast
 
 
 class OpenSCoP:
-    def __init__(self, root, kwargs):
+    def __init__(self, func, root, kwargs):
         print(dump_ast(root))
 
         self.domain_stack = []
@@ -10,6 +10,8 @@ import ast
 import inspect
 import phylanx.execution_tree
 from phylanx import compiler_state
+from .loop_transformations import default_tile_size, tile_loops, \
+    vectorize_loops
 
 mapped_methods = {
     "add": "__add",
@@ -88,6 +90,82 @@ def remove_line(a):
     return re.sub(r'\$.*', '', a)
 
 
+def subscript_index(node):
+    """Returns the index expression of a `Subscript` node."""
+
+    if isinstance(node.slice, ast.Index):
+        return node.slice.value
+    return node.slice
+
+
+def has_loop_carried_dependencies(node):
+    """Conservatively decides whether the iterations of the `for` loop `node`
+    may depend on each other.
+
+    The iterations are considered independent if the loop body
+        - does not leave the loop early (`break`, `continue`, `return`),
+        - does not assign to variables, and
+        - writes to arrays only at the position given by the loop variable
+          (`a[i] = ...` or `a[i, ...] = ...`) and reads the written arrays at
+          that same position only.
+    """
+
+    if not isinstance(node.target, ast.Name):
+        return True
+    loop_var = node.target.id
+
+    def indexed_by_loop_var(index):
+        if isinstance(index, ast.Tuple) and index.elts:
+            index = index.elts[0]
+        return isinstance(index, ast.Name) and index.id == loop_var
+
+    # the index expressions used to write to arrays, keyed by array name
+    stores = {}
+    body = [n for stmt in node.body for n in ast.walk(stmt)]
+
+    for n in body:
+        if isinstance(n, (ast.Break, ast.Continue, ast.Return)):
+            return True
+
+        if isinstance(n, ast.AugAssign):
+            targets = [n.target]
+        elif isinstance(n, ast.Assign):
+            targets = n.targets
+        else:
+            continue
+
+        for target in targets:
+            if isinstance(target, ast.Name):
+                # a variable is a single object shared by all iterations,
+                # even if it is used as a temporary inside the body only
+                return True
+            elif isinstance(target, ast.Subscript) and \
+                    isinstance(target.value, ast.Name):
+                index = subscript_index(target)
+                if not indexed_by_loop_var(index):
+                    return True
+                dump = ast.dump(index)
+                if stores.setdefault(target.value.id, dump) != dump:
+                    return True
+            else:
+                return True
+
+    # arrays written to may be read at the written position only
+    for n in body:
+        if isinstance(n, ast.Subscript) and isinstance(n.value, ast.Name) \
+                and n.value.id in stores:
+            if ast.dump(subscript_index(n)) != stores[n.value.id]:
+                return True
+        elif isinstance(n, ast.Name) and isinstance(n.ctx, ast.Load) and \
+                n.id in stores:
+            # the array is used as a whole
+            if not any(isinstance(p, ast.Subscript) and p.value is n
+                       for p in body):
+                return True
+
+    return False
+
+
 class PhySL:
     """Python AST to PhySL Transducer."""
 
@@ -110,6 +188,14 @@ class PhySL:
         else:
             PhySL.defined_classes = {}
 
+        # interchange and tile the affine loop nests for better locality
+        if kwargs.get("tiling"):
+            tree = tile_loops(tree, kwargs.get("tile_size", default_tile_size))
+
+        # replace elementwise loops with whole array operations
+        if kwargs.get("vectorize", True):
+            tree = vectorize_loops(tree)
+
         self.ir = self.apply_rule(tree.body[0])
         self.__src__ = self.generate_physl(self.ir)
 
@@ -123,7 +209,13 @@ class PhySL:
         elif PhySL.compiler_state is None:
             PhySL.compiler_state = compiler_state()
 
-        phylanx.execution_tree.compile(self.file_name, self.__src__, PhySL.compiler_state)
+        # later invocations have to use the state the function is compiled
+        # into, even if another function selects a different state
+        self.__compiler_state__ = PhySL.compiler_state
+
+        phylanx.execution_tree.compile(
+            self.file_name, self.__src__, self.__compiler_state__)
+        self.__compiled_function__ = None
 
     def generate_physl(self, ir):
         if len(ir) == 2 and isinstance(ir[0], str) and isinstance(
@@ -158,10 +250,37 @@ class PhySL:
             block = (self.apply_rule(node), )
             return block
 
+    def compiled_function(self):
+        """Returns the pre-compiled callable for the wrapped function.
+
+        The function is compiled on first use only, subsequent invocations
+        merely convert the arguments and evaluate the existing execution tree.
+        """
+
+        if self.__compiled_function__ is None:
+            func_name = self.wrapped_function.__name__
+            self.__compiled_function__ = \
+                phylanx.execution_tree.compiled_function(
+                    func_name, self.__compiler_state__)
+        return self.__compiled_function__
+
     def call(self, args):
-        func_name = self.wrapped_function.__name__
-        return phylanx.execution_tree.eval(func_name, PhySL.compiler_state,
-                                           *args)
+        return self.compiled_function()(*args)
+
+    def call_async(self, args):
+        return self.compiled_function().call_async(*args)
+
+    def map_batch(self, arg_sets):
+        return self.compiled_function().map_batch(arg_sets)
+
+    def lazy(self, args):
+        """Returns a graph node representing the deferred invocation of the
+        wrapped function, see `phylanx.execution_tree.lazy_array`."""
+
+        return phylanx.execution_tree.lazy_array(
+            primitive=self.wrapped_function.__name__,
+            operands=args,
+            compiler_state=self.__compiler_state__)
 
 # #############################################################################
 # Transducer rules
@@ -442,9 +561,17 @@ class PhySL:
             'list': 'for_each',
             'slice': 'for_each',
             'range': 'for_each',
-            'prange': 'parallel_map'
+            'prange': 'parallel_for_each'
         }
 
+        # iterations of a prange loop are executed concurrently only if they
+        # don't depend on each other, otherwise the loop is run sequentially.
+        parallel = False
+        if isinstance(node.iter, ast.Call) and \
+                isinstance(node.iter.func, ast.Name) and \
+                node.iter.func.id == 'prange':
+            parallel = not has_loop_carried_dependencies(node)
+
         target = self.apply_rule(node.target)
         # TODO: **MAP**
         # target_name = target.split('$', 1)[0]
@@ -454,6 +581,8 @@ class PhySL:
         # extract the type of the iteration space- used as the lookup key in
         # `mapping_function` dictionary above.
         symbol_name = mapping_function[iteration_space[0].split('$', 1)[0]]
+        if symbol_name == 'parallel_for_each' and not parallel:
+            symbol_name = 'for_each'
         symbol = get_symbol_info(node, symbol_name)
 
         # replace keyword `prange` to `range` for compatibility with Phylanx.
@@ -461,6 +590,17 @@ class PhySL:
         body = self.block(node.body)
         # orelse = self.block(node.orelse)
         op = get_symbol_info(node, 'lambda')
+
+        # prange(..., grain_size=n) specifies the number of iterations run by
+        # one task
+        if parallel:
+            for keyword in node.iter.keywords:
+                if keyword.arg == 'grain_size':
+                    grain_size = self.apply_rule(keyword.value)
+                    return [symbol,
+                            ([op, (target, body)], iteration_space,
+                             grain_size)]
+
         return [symbol, ([op, (target, body)], iteration_space)]
         # return [symbol, (target, iteration_space, body, orelse)]
 
@@ -22,7 +22,10 @@ def Phylanx(__phylanx_arg=None, **kwargs):
             """
             :function:f the decorated funtion.
             """
-            valid_kwargs = ['debug', 'target', 'compiler_state']
+            valid_kwargs = [
+                'debug', 'target', 'compiler_state', 'lazy', 'tiling',
+                'tile_size', 'vectorize'
+            ]
 
             self.backends_map = {'PhySL': PhySL, 'OpenSCoP': OpenSCoP}
             self.backend = self.get_backend(kwargs.get('target'))
@@ -78,8 +81,44 @@ def Phylanx(__phylanx_arg=None, **kwargs):
             if self.backend == 'OpenSCoP':
                 raise NotImplementedError(
                     "OpenSCoP kernels are not yet callable.")
+            if kwargs.get('lazy'):
+                return self.backend.lazy(args)
             return self.backend.call(args)
 
+        def call_async(self, *args):
+            """Start evaluating the function and return a future object.
+
+            The returned future can be waited on (`result()`) or awaited from
+            within an asyncio coroutine. The GIL is not held while Phylanx
+            computes the result.
+            """
+            if self.backend == 'OpenSCoP':
+                raise NotImplementedError(
+                    "OpenSCoP kernels are not yet callable.")
+            return self.backend.call_async(args)
+
+        def map_batch(self, arg_sets):
+            """Evaluate the function for each of the given argument tuples.
+
+            The evaluations run concurrently, the list of results is returned.
+            """
+            if self.backend == 'OpenSCoP':
+                raise NotImplementedError(
+                    "OpenSCoP kernels are not yet callable.")
+            return self.backend.map_batch(arg_sets)
+
+        def lazy(self, *args):
+            """Defer the invocation of the function.
+
+            Returns a graph node (`phylanx.execution_tree.lazy_array`), the
+            invocations of all functions combined this way are compiled into
+            a single PhySL program that is run on `compute()`.
+            """
+            if self.backend == 'OpenSCoP':
+                raise NotImplementedError(
+                    "OpenSCoP kernels are not yet callable.")
+            return self.backend.lazy(args)
+
         def generate_ast(self):
             return generate_phylanx_ast(self.__src__)
 
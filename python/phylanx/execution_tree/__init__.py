@@ -3,8 +3,50 @@
 # Distributed under the Boost Software License, Version 1.0. (See accompanying
 # file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+import asyncio
+
 try:
     from phylanx._phylanx.execution_tree import *
 
 except Exception:
     from phylanx._phylanxd.execution_tree import *
+
+from .lazy_array import lazy_array
+
+
+def _future_await(self):
+    """Make the futures returned by `eval_async` awaitable from asyncio.
+
+    The result is transferred to an asyncio future owned by the current event
+    loop once the evaluation has finished. This happens on an HPX thread,
+    therefore the transfer is scheduled using `call_soon_threadsafe`.
+    """
+
+    loop = asyncio.get_event_loop()
+    awaitable = loop.create_future()
+
+    def transfer(f):
+        if awaitable.cancelled():
+            return
+        try:
+            awaitable.set_result(f.result())
+        except Exception as e:
+            awaitable.set_exception(e)
+
+    self.add_done_callback(lambda f: loop.call_soon_threadsafe(transfer, f))
+    return awaitable.__await__()
+
+
+future.__await__ = _future_await
+
+
+def map_batch(fn, arg_sets):
+    """Evaluate `fn` for each of the given argument tuples.
+
+    `fn` is either a `compiled_function` or a function decorated with
+    `@Phylanx`. All arguments are converted up front and the evaluations run
+    concurrently, the list of results is returned in the order of
+    `arg_sets`.
+    """
+
+    return fn.map_batch(arg_sets)
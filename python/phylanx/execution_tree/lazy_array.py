@@ -0,0 +1,245 @@
+# Copyright (c) 2018 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+'''
+Lazily evaluated arrays whose data is kept in Blaze storage on the C++ side.
+
+NumPy operations on a `lazy_array` (ufuncs through `__array_ufunc__`, other
+functions through `__array_function__`) do not compute anything. Instead they
+record the corresponding PhySL primitive. Functions decorated with
+`@Phylanx(lazy=True)` (or invoked through their `lazy` method) are recorded the
+same way. The recorded expression is compiled into a single PhySL function and
+is evaluated only if the result is needed, either explicitly (`evaluate()`,
+`compute()`) or by converting the array to NumPy.
+'''
+
+import numpy as np
+import numpy.lib.mixins
+import phylanx
+
+# NumPy ufuncs supported by lazy arrays and their PhySL counterparts
+mapped_ufuncs = {
+    'absolute': 'absolute',
+    'add': '__add',
+    'arccos': 'arccos',
+    'arccosh': 'arccosh',
+    'arcsin': 'arcsin',
+    'arcsinh': 'arcsinh',
+    'arctan': 'arctan',
+    'arctanh': 'arctanh',
+    'cbrt': 'cbrt',
+    'ceil': 'ceil',
+    'cos': 'cos',
+    'divide': '__div',
+    'equal': '__eq',
+    'exp': 'exp',
+    'exp2': 'exp2',
+    'floor': 'floor',
+    'greater': '__gt',
+    'greater_equal': '__ge',
+    'less': '__lt',
+    'less_equal': '__le',
+    'log': 'log',
+    'log10': 'log10',
+    'log2': 'log2',
+    'logical_and': '__and',
+    'logical_not': '__not',
+    'logical_or': '__or',
+    'matmul': 'dot',
+    'multiply': '__mul',
+    'negative': '__minus',
+    'not_equal': '__ne',
+    'power': 'power',
+    'rint': 'rint',
+    'sin': 'sin',
+    'sqrt': 'sqrt',
+    'subtract': '__sub',
+    'tan': 'tan',
+    'true_divide': '__div',
+    'trunc': 'trunc',
+}
+
+# NumPy functions supported by lazy arrays and their PhySL counterparts,
+# the given keyword arguments are passed as additional positional arguments
+mapped_functions = {
+    np.amax: ('amax', ['axis']),
+    np.amin: ('amin', ['axis']),
+    np.argmax: ('argmax', ['axis']),
+    np.argmin: ('argmin', ['axis']),
+    np.dot: ('dot', []),
+    np.mean: ('mean', ['axis']),
+    np.sum: ('sum', ['axis']),
+    np.transpose: ('transpose', []),
+    np.where: ('where', []),
+}
+
+
+def default_compiler_state():
+    """Returns the compiler state shared with the functions decorated with
+    `@Phylanx`."""
+
+    physl = phylanx.ast.physl.PhySL
+    if physl.compiler_state is None:
+        physl.compiler_state = phylanx.compiler_state()
+    return physl.compiler_state
+
+
+class lazy_array(numpy.lib.mixins.NDArrayOperatorsMixin):
+    """An array whose value is computed by PhySL on demand."""
+
+    __compiled_functions__ = {}
+
+    def __init__(self, value=None, primitive=None, operands=(),
+                 compiler_state=None):
+        if primitive is None:
+            # leaf node, move the data to the C++ side exactly once
+            if isinstance(value, phylanx.execution_tree.primitive):
+                self.variable = value
+            else:
+                self.variable = phylanx.execution_tree.variable(
+                    np.asarray(value))
+        else:
+            self.variable = None
+        self.primitive = primitive
+        self.operands = tuple(operands)
+        # user defined functions have to be invoked in the compiler state
+        # they were defined in
+        self.compiler_state = compiler_state
+
+    # #########################################################################
+    # code generation
+    def _collect(self, args, names, states):
+        """Returns the PhySL expression for this node. The values the
+        expression refers to are appended to `args`, the compiler states
+        required by the expression are added to `states`."""
+
+        if self.variable is not None:
+            key = id(self.variable)
+            if key not in names:
+                names[key] = 'a%d' % len(args)
+                args.append(self.variable)
+            return names[key]
+
+        if self.compiler_state is not None:
+            states[id(self.compiler_state)] = self.compiler_state
+
+        operands = []
+        for operand in self.operands:
+            if isinstance(operand, lazy_array):
+                operands.append(operand._collect(args, names, states))
+            else:
+                # scalars and arrays are passed as arguments as well, this
+                # allows to reuse the compiled function for other values
+                operands.append('a%d' % len(args))
+                args.append(operand)
+        return '%s(%s)' % (self.primitive, ', '.join(operands))
+
+    def _compiled_function(self):
+        """Compiles the recorded expression into a PhySL function, functions
+        are cached based on the structure of the expression."""
+
+        args = []
+        states = {}
+        expr = self._collect(args, {}, states)
+
+        if len(states) > 1:
+            raise ValueError(
+                "lazy_array: the expression refers to functions defined in "
+                "different compiler states")
+        state = states.popitem()[1] if states else default_compiler_state()
+
+        # the compiled function keeps the compiler state alive, thus its id
+        # is unique for as long as the cache entry exists
+        key = (id(state), expr)
+        func = lazy_array.__compiled_functions__.get(key)
+        if func is None:
+            fname = '__lazy_array%d' % len(lazy_array.__compiled_functions__)
+            params = ''.join(', a%d' % i for i in range(len(args)))
+            src = 'block(define(%s%s, %s), %s)' % (fname, params, expr, fname)
+
+            func = phylanx.execution_tree.compiled_function(src, state)
+            lazy_array.__compiled_functions__[key] = func
+
+        return func, args
+
+    # #########################################################################
+    # evaluation
+    def evaluate(self):
+        """Evaluates the recorded expression, the result stays on the C++
+        side. Returns `self`."""
+
+        if self.variable is None:
+            func, args = self._compiled_function()
+            self.variable = func.call_as_variable(*args)
+            self.primitive = None
+            self.operands = ()
+            self.compiler_state = None
+        return self
+
+    def compute(self):
+        """Evaluates the recorded expression and returns the result as a
+        NumPy array (or scalar)."""
+
+        if self.variable is not None:
+            return self.variable.eval()
+        func, args = self._compiled_function()
+        return func(*args)
+
+    def __array__(self, dtype=None):
+        return np.asarray(self.compute(), dtype=dtype)
+
+    def __float__(self):
+        return float(self.compute())
+
+    def __int__(self):
+        return int(self.compute())
+
+    def __bool__(self):
+        return bool(self.compute())
+
+    def __repr__(self):
+        return 'lazy_array(%r)' % (self.compute(), )
+
+    def __getitem__(self, key):
+        return np.asarray(self)[key]
+
+    @property
+    def T(self):
+        return lazy_array(primitive='transpose', operands=(self, ))
+
+    # #########################################################################
+    # NumPy protocols
+    def __array_ufunc__(self, ufunc, method, *inputs, **kwargs):
+        primitive = mapped_ufuncs.get(ufunc.__name__)
+        if method != '__call__' or kwargs or primitive is None:
+            # fall back to NumPy
+            inputs = tuple(
+                np.asarray(x) if isinstance(x, lazy_array) else x
+                for x in inputs)
+            return getattr(ufunc, method)(*inputs, **kwargs)
+
+        return lazy_array(primitive=primitive, operands=inputs)
+
+    def __array_function__(self, func, types, args, kwargs):
+        mapped = mapped_functions.get(func)
+        if mapped is not None and set(kwargs) <= set(mapped[1]):
+            primitive, keywords = mapped
+            operands = list(args)
+            for key in keywords:
+                if key in kwargs and kwargs[key] is not None:
+                    operands.append(kwargs[key])
+            return lazy_array(primitive=primitive, operands=operands)
+
+        # fall back to NumPy
+        args = tuple(
+            np.asarray(x) if isinstance(x, lazy_array) else x for x in args)
+        return func(*args, **kwargs)
+
+
+def asarray(value):
+    """Wraps the given value into a `lazy_array`."""
+
+    if isinstance(value, lazy_array):
+        return value
+    return lazy_array(value)
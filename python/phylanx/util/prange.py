@@ -12,11 +12,14 @@ https://github.com/numba/numba/blob/master/numba/special.py
 
 
 class prange(object):
-    def __init__(self, *args):
+    def __init__(self, *args, grain_size=None):
         # remember range(0, n) iteration space
         # remember range(0, n, k) iteration broken into chunks
         #
+        # grain_size is the number of iterations executed by one task once
+        # the loop has been transformed by @Phylanx, it is ignored otherwise
         self.iterspace = range(*args)
+        self.grain_size = grain_size
 
     def __iter__(self):
         for i in self.iterspace:
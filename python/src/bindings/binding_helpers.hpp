@@ -12,10 +12,15 @@
 
 #include <pybind11/pybind11.h>
 
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/mutex.hpp>
 #include <hpx/runtime/threads/run_as_hpx_thread.hpp>
 
 #include <cstdint>
 #include <exception>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -39,6 +44,12 @@ namespace phylanx { namespace bindings
         phylanx::execution_tree::compiler::environment eval_env;
         phylanx::execution_tree::compiler::function_list eval_snippets;
 
+        // The variables of a compiled function are shared by all of its
+        // invocations, all evaluations of code compiled into this state are
+        // therefore serialized.
+        using mutex_type = hpx::lcos::local::mutex;
+        std::shared_ptr<mutex_type> eval_mtx;
+
         static pybind11::object import_phylanx()
         {
 #if defined(_DEBUG)
@@ -52,6 +63,7 @@ namespace phylanx { namespace bindings
           : m(import_phylanx())
           , eval_env(phylanx::execution_tree::compiler::default_environment())
           , eval_snippets()
+          , eval_mtx(std::make_shared<mutex_type>())
         {
         }
     };
@@ -167,6 +179,37 @@ namespace phylanx { namespace bindings
             });
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Compile the given expression and return the resulting invocable,
+        // this has to be called on an HPX thread while holding the GIL.
+        inline phylanx::execution_tree::compiler::function compile_expression(
+            std::string const& xexpr_str, compiler_state& c)
+        {
+            auto xexpr = phylanx::ast::generate_ast(xexpr_str);
+            auto const& code_x = phylanx::execution_tree::compile(
+                xexpr, c.eval_snippets, c.eval_env);
+            return code_x.run();
+        }
+
+        // Convert the Python arguments for invoking a compiled function, the
+        // GIL has to be held while calling this.
+        inline phylanx::execution_tree::primitive_arguments_type
+        convert_arguments(pybind11::tuple const& args)
+        {
+            phylanx::execution_tree::primitive_arguments_type fargs;
+            fargs.reserve(args.size());
+
+            for (auto const& item : args)
+            {
+                fargs.emplace_back(item.cast<
+                    phylanx::execution_tree::primitive_argument_type>());
+            }
+            return fargs;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     inline phylanx::execution_tree::primitive_argument_type
     expression_evaluator(
@@ -178,29 +221,298 @@ namespace phylanx { namespace bindings
             [&]() -> phylanx::execution_tree::primitive_argument_type
             {
                 pybind11::gil_scoped_acquire acquire;
-                auto xexpr = phylanx::ast::generate_ast(xexpr_str);
-                auto const& code_x = phylanx::execution_tree::compile(
-                    xexpr, c.eval_snippets, c.eval_env);
-                auto x = code_x.run();
+                auto x = detail::compile_expression(xexpr_str, c);
+                auto fargs = detail::convert_arguments(args);
+
+                pybind11::gil_scoped_release release;       // release GIL
+
+                std::lock_guard<compiler_state::mutex_type> l(*c.eval_mtx);
+                return phylanx::execution_tree::extract_copy_value(
+                    x(std::move(fargs)));
+            });
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Python objects referenced from HPX threads must be released while
+    // holding the GIL
+    inline std::shared_ptr<pybind11::object> hold_python_object(
+        pybind11::object obj)
+    {
+        return std::shared_ptr<pybind11::object>(
+            new pybind11::object(std::move(obj)),
+            [](pybind11::object* p)
+            {
+                pybind11::gil_scoped_acquire acquire;       // acquire GIL
+                delete p;
+            });
+    }
+
+    // support for asynchronous evaluation, this mimics the interface of
+    // concurrent.futures.Future
+    struct evaluation_future
+    {
+        using result_type = phylanx::execution_tree::primitive_argument_type;
 
-                phylanx::execution_tree::primitive_arguments_type keep_alive;
-                keep_alive.reserve(args.size());
+        bool done() const
+        {
+            return f_.is_ready();
+        }
+
+        result_type result() const
+        {
+            // done-callbacks run on HPX threads and may access the result
+            if (hpx::threads::get_self_ptr() != nullptr)
+            {
+                return f_.get();
+            }
+
+            pybind11::gil_scoped_release release;       // release GIL
+
+            return hpx::threads::run_as_hpx_thread(
+                [&]() -> result_type
+                {
+                    return f_.get();
+                });
+        }
+
+        // the given function is invoked with the future object as its only
+        // argument as soon as the result is available, the function is
+        // invoked on an HPX thread while holding the GIL
+        void add_done_callback(pybind11::object self, pybind11::object func)
+        {
+            auto s = hold_python_object(std::move(self));
+            auto fn = hold_python_object(std::move(func));
+
+            pybind11::gil_scoped_release release;       // release GIL
+
+            hpx::threads::run_as_hpx_thread(
+                [&]() -> void
+                {
+                    f_.then(hpx::launch::async,
+                        [s, fn](hpx::shared_future<result_type> const&)
+                        {
+                            pybind11::gil_scoped_acquire acquire;
+                            try
+                            {
+                                (*fn)(*s);
+                            }
+                            catch (pybind11::error_already_set& e)
+                            {
+                                // there is nobody to report the error to
+                                e.restore();
+                                PyErr_WriteUnraisable(fn->ptr());
+                            }
+                        });
+                });
+        }
+
+        hpx::shared_future<result_type> f_;
+    };
+
+    namespace detail
+    {
+        // Evaluate the given function while holding the lock of the
+        // compiler state it was compiled into. The result is copied as it
+        // might refer to data which is overwritten by the next evaluation.
+        inline phylanx::execution_tree::primitive_argument_type
+        evaluate_locked(phylanx::execution_tree::compiler::function const& x,
+            phylanx::execution_tree::primitive_arguments_type&& fargs,
+            compiler_state::mutex_type& mtx)
+        {
+            std::lock_guard<compiler_state::mutex_type> l(mtx);
+            return phylanx::execution_tree::extract_copy_value(
+                x(std::move(fargs)));
+        }
+
+        // Start evaluating the given function, this has to be called on an
+        // HPX thread.
+        inline evaluation_future evaluate_async(
+            phylanx::execution_tree::compiler::function const& x,
+            phylanx::execution_tree::primitive_arguments_type&& fargs,
+            std::shared_ptr<compiler_state::mutex_type> const& mtx)
+        {
+            return evaluation_future{hpx::async(
+                [x, fargs = std::move(fargs), mtx]() mutable
+                {
+                    return evaluate_locked(x, std::move(fargs), *mtx);
+                })};
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Compile the given expression and start evaluating it without waiting
+    // for the result. The GIL is not held while the expression is evaluated.
+    inline evaluation_future expression_evaluator_async(
+        std::string xexpr_str, compiler_state& c, pybind11::args args)
+    {
+        pybind11::gil_scoped_release release;       // release GIL
+
+        return hpx::threads::run_as_hpx_thread(
+            [&]() -> evaluation_future
+            {
+                phylanx::execution_tree::compiler::function x;
                 phylanx::execution_tree::primitive_arguments_type fargs;
-                fargs.reserve(args.size());
 
-                for (auto const& item : args)
                 {
-                    phylanx::execution_tree::primitive_argument_type value =
-                        item.cast<
-                            phylanx::execution_tree::primitive_argument_type>();
-                    keep_alive.emplace_back(std::move(value));
-                    fargs.emplace_back(extract_ref_value(keep_alive.back()));
+                    pybind11::gil_scoped_acquire acquire;
+                    x = detail::compile_expression(xexpr_str, c);
+                    fargs = detail::convert_arguments(args);
                 }
 
-                pybind11::gil_scoped_release release;       // release GIL
-                return x(std::move(fargs));
+                return detail::evaluate_async(
+                    x, std::move(fargs), c.eval_mtx);
             });
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A pre-compiled, reusable function. The expression is compiled only
+    // once, invoking the function merely converts the arguments and evaluates
+    // the already existing execution tree. Invocations are serialized with
+    // all other evaluations of code compiled into the same compiler state.
+    struct compiled_function
+    {
+        using result_type = phylanx::execution_tree::primitive_argument_type;
+
+        compiled_function(std::string const& xexpr_str, compiler_state& c)
+          : mtx_(c.eval_mtx)
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            func_ = hpx::threads::run_as_hpx_thread(
+                [&]() -> phylanx::execution_tree::compiler::function
+                {
+                    pybind11::gil_scoped_acquire acquire;
+                    return detail::compile_expression(xexpr_str, c);
+                });
+        }
+
+        result_type operator()(pybind11::args args) const
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            return hpx::threads::run_as_hpx_thread(
+                [&]() -> result_type
+                {
+                    phylanx::execution_tree::primitive_arguments_type fargs;
+
+                    {
+                        pybind11::gil_scoped_acquire acquire;
+                        fargs = detail::convert_arguments(args);
+                    }
+
+                    return detail::evaluate_locked(
+                        func_, std::move(fargs), *mtx_);
+                });
+        }
+
+        evaluation_future call_async(pybind11::args args) const
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            return hpx::threads::run_as_hpx_thread(
+                [&]() -> evaluation_future
+                {
+                    phylanx::execution_tree::primitive_arguments_type fargs;
+
+                    {
+                        pybind11::gil_scoped_acquire acquire;
+                        fargs = detail::convert_arguments(args);
+                    }
+
+                    return detail::evaluate_async(
+                        func_, std::move(fargs), mtx_);
+                });
+        }
+
+        // Evaluate the function and store the result in a new variable, this
+        // keeps the data on the C++ side instead of converting it to Python.
+        phylanx::execution_tree::primitive call_as_variable(
+            pybind11::args args) const
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            return hpx::threads::run_as_hpx_thread(
+                [&]() -> phylanx::execution_tree::primitive
+                {
+                    phylanx::execution_tree::primitive_arguments_type fargs;
+
+                    {
+                        pybind11::gil_scoped_acquire acquire;
+                        fargs = detail::convert_arguments(args);
+                    }
+
+                    return phylanx::execution_tree::create_primitive_component(
+                        hpx::find_here(), "variable",
+                        detail::evaluate_locked(
+                            func_, std::move(fargs), *mtx_));
+                });
+        }
+
+        // Evaluate the function for each of the given argument sets. All
+        // arguments are converted up front and a list of all results is
+        // returned. This amortizes the cost of switching between Python and
+        // HPX over all invocations. The evaluations are scheduled
+        // concurrently but run one at a time, as they share the variables of
+        // the execution tree.
+        std::vector<result_type> map_batch(pybind11::iterable arg_sets) const
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            return hpx::threads::run_as_hpx_thread(
+                [&]() -> std::vector<result_type>
+                {
+                    std::vector<
+                        phylanx::execution_tree::primitive_arguments_type>
+                        fargs;
+
+                    {
+                        pybind11::gil_scoped_acquire acquire;
+                        for (auto const& item : arg_sets)
+                        {
+                            // a single argument doesn't need to be wrapped
+                            // into a tuple
+                            if (pybind11::isinstance<pybind11::tuple>(item))
+                            {
+                                fargs.emplace_back(detail::convert_arguments(
+                                    item.cast<pybind11::tuple>()));
+                            }
+                            else
+                            {
+                                fargs.emplace_back(detail::convert_arguments(
+                                    pybind11::make_tuple(item)));
+                            }
+                        }
+                    }
+
+                    std::vector<hpx::future<result_type>> results;
+                    results.reserve(fargs.size());
+
+                    for (auto&& args : fargs)
+                    {
+                        results.emplace_back(hpx::async(
+                            [f = func_, args = std::move(args),
+                                mtx = mtx_]() mutable
+                            {
+                                return detail::evaluate_locked(
+                                    f, std::move(args), *mtx);
+                            }));
+                    }
+
+                    hpx::wait_all(results);
+
+                    std::vector<result_type> values;
+                    values.reserve(results.size());
+                    for (auto&& f : results)
+                    {
+                        values.emplace_back(f.get());
+                    }
+                    return values;
+                });
+        }
+
+        std::shared_ptr<compiler_state::mutex_type> mtx_;
+        phylanx::execution_tree::compiler::function func_;
+    };
 }}
 
 #endif
@@ -13,6 +13,7 @@
 #include <pybind11/pybind11.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -67,6 +68,19 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
                 });
         },
         "create a new variable from a matrix floating point values");
+    execution_tree.def("variable",
+        [](phylanx::execution_tree::primitive_argument_type value) {
+            pybind11::gil_scoped_release release;       // release GIL
+            return hpx::threads::run_as_hpx_thread(
+                [&]()
+                {
+                    using namespace phylanx::execution_tree;
+                    return create_primitive_component(
+                        hpx::find_here(), "variable", std::move(value));
+                });
+        },
+        "create a new variable from an arbitrary value (e.g. a numpy array), "
+        "the data is held on the C++ side");
 
     execution_tree.def("compile", phylanx::bindings::expression_compiler,
         "compile a numerical expression in PhySL");
@@ -74,6 +88,53 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
     execution_tree.def("eval", phylanx::bindings::expression_evaluator,
         "compile and evaluate a numerical expression in PhySL");
 
+    execution_tree.def("eval_async",
+        phylanx::bindings::expression_evaluator_async,
+        "compile and asynchronously evaluate a numerical expression in "
+        "PhySL, returns a future object referring to the result");
+
+    pybind11::class_<phylanx::bindings::compiled_function>(execution_tree,
+        "compiled_function", "type representing a pre-compiled PhySL "
+            "function that can be invoked repeatedly")
+        .def(pybind11::init<std::string const&,
+                phylanx::bindings::compiler_state&>(),
+            // keep the compiler state alive as long as the function exists
+            pybind11::keep_alive<1, 3>(),
+            "compile the given PhySL expression once, the result can be "
+            "invoked without recompiling it")
+        .def("__call__", &phylanx::bindings::compiled_function::operator(),
+            "evaluate the compiled function for the given arguments")
+        .def("call_async", &phylanx::bindings::compiled_function::call_async,
+            "asynchronously evaluate the compiled function for the given "
+            "arguments, returns a future object referring to the result")
+        .def("call_as_variable",
+            &phylanx::bindings::compiled_function::call_as_variable,
+            "evaluate the compiled function for the given arguments and "
+            "store the result in a new variable instead of converting it "
+            "to Python")
+        .def("map_batch", &phylanx::bindings::compiled_function::map_batch,
+            "concurrently evaluate the compiled function for each of the "
+            "given argument tuples, returns the list of results")
+    ;
+
+    pybind11::class_<phylanx::bindings::evaluation_future>(execution_tree,
+        "future", "type representing the result of an asynchronous "
+            "evaluation of a PhySL expression")
+        .def("done", &phylanx::bindings::evaluation_future::done,
+            "return whether the result of the evaluation is available")
+        .def("result", &phylanx::bindings::evaluation_future::result,
+            "wait for the evaluation to finish and return its result "
+            "(the GIL is released while waiting)")
+        .def("add_done_callback",
+            [](pybind11::object self, pybind11::object func)
+            {
+                self.cast<phylanx::bindings::evaluation_future&>()
+                    .add_done_callback(self, std::move(func));
+            },
+            "attach a callable that will be invoked with this future as its "
+            "only argument once the evaluation has finished")
+    ;
+
     pybind11::class_<phylanx::execution_tree::primitive>(execution_tree,
         "primitive", "type representing an arbitrary execution tree")
         .def(pybind11::init<>())
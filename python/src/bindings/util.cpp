@@ -12,12 +12,15 @@
 #include <bindings/binding_helpers.hpp>
 #include <bindings/type_casters.hpp>
 
+#include <hpx/runtime/threads/run_as_hpx_thread.hpp>
+
 #include <pybind11/pybind11.h>
 
 #include <cstdint>
-#include <vector>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 // expose util submodule
@@ -88,4 +91,59 @@ void phylanx::bindings::bind_util(pybind11::module m)
                 return phylanx::execution_tree::list_patterns();
             },
             "display help strings for Phylanx primitives and plugins.");
+
+    util.def("enable_measurements",
+        [](bool size_histogram) -> std::vector<std::string>
+        {
+            return hpx::threads::run_as_hpx_thread([&]() {
+                return phylanx::util::enable_measurements(size_histogram);
+            });
+        },
+        pybind11::arg("size_histogram") = false,
+        "enable the collection of performance data for all existing "
+        "primitives, optionally bucketed by the number of elements involved "
+        "in each evaluation");
+    util.def("retrieve_size_histogram",
+        [](bool reset)
+        -> std::map<std::string,
+            std::vector<std::pair<std::int64_t, std::int64_t>>>
+        {
+            return hpx::threads::run_as_hpx_thread([&]() {
+                return phylanx::util::retrieve_size_histogram(reset);
+            });
+        },
+        pybind11::arg("reset") = false,
+        "return a dictionary mapping primitive instance names to a list of "
+        "(eval count, eval duration [ns]) pairs, where entry k accounts for "
+        "evaluations involving [2**k, 2**(k+1)) elements");
+    util.def("retrieve_all_counter_data",
+        [](std::vector<std::string> const& counters) -> pybind11::dict
+        {
+            phylanx::util::counter_data_summary data =
+                hpx::threads::run_as_hpx_thread([&]() {
+                    if (counters.empty())
+                    {
+                        return phylanx::util::retrieve_all_counter_data()
+                            .get();
+                    }
+                    return phylanx::util::retrieve_all_counter_data(counters)
+                        .get();
+                });
+
+            pybind11::dict result;
+            result["counters"] = pybind11::cast(data.counter_names);
+            result["instances"] = pybind11::cast(data.instances);
+            result["primitives"] = pybind11::cast(data.primitives);
+            result["localities"] = pybind11::cast(data.localities);
+            result["load_imbalance"] = pybind11::cast(data.load_imbalance);
+            return result;
+        },
+        pybind11::arg("counters") = std::vector<std::string>{},
+        "collect the given performance counters (default: count/eval, "
+        "time/eval, eval_direct) for all primitives from all localities, "
+        "return a dictionary holding the values for each primitive "
+        "instance ('instances'), accumulated for each primitive type "
+        "('primitives') and for each locality ('localities'), and the ratio "
+        "of the largest to the average per-locality value for each counter "
+        "('load_imbalance')");
 }
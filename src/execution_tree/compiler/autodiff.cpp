@@ -0,0 +1,685 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/ast/detail/tagged_id.hpp>
+#include <phylanx/ast/match_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compiler/autodiff.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // helpers for generating code
+        ast::expression call(std::string const& name,
+            std::vector<ast::expression>&& args)
+        {
+            return ast::expression(
+                ast::function_call(ast::identifier(name), std::move(args)));
+        }
+
+        ast::expression call(std::string const& name, ast::expression arg)
+        {
+            return call(name, std::vector<ast::expression>{std::move(arg)});
+        }
+
+        ast::expression call(std::string const& name, ast::expression arg1,
+            ast::expression arg2)
+        {
+            return call(name,
+                std::vector<ast::expression>{std::move(arg1), std::move(arg2)});
+        }
+
+        ast::expression variable(std::string const& name)
+        {
+            return ast::expression(ast::identifier(name));
+        }
+
+        // number of dimensions of the given value: len(shape(x))
+        ast::expression ndim(ast::expression const& x)
+        {
+            return call("len", call("shape", x));
+        }
+
+        ast::expression ndim_equals(ast::expression const& x, std::int64_t n)
+        {
+            return call("__eq", ndim(x), ast::expression(n));
+        }
+
+        ast::expression if_(ast::expression cond, ast::expression then_,
+            ast::expression else_)
+        {
+            return call("if", std::vector<ast::expression>{
+                std::move(cond), std::move(then_), std::move(else_)});
+        }
+
+        // reduce the adjoint of a broadcast scalar operand
+        ast::expression unbroadcast(
+            ast::expression const& adjoint, ast::expression const& x)
+        {
+            return if_(call("__and", ndim_equals(x, 0),
+                           call("__not", ndim_equals(adjoint, 0))),
+                call("sum", adjoint), adjoint);
+        }
+
+        // broadcast the scalar adjoint of a reduction to the shape of x
+        ast::expression broadcast_like(
+            ast::expression const& adjoint, ast::expression const& x)
+        {
+            return if_(ndim_equals(x, 0), adjoint,
+                call("__mul", adjoint,
+                    call("constant", ast::expression(1.0), call("shape", x))));
+        }
+
+        // number of elements of x
+        ast::expression size(ast::expression const& x)
+        {
+            return if_(ndim_equals(x, 0), ast::expression(1.0),
+                call("sum",
+                    call("constant", ast::expression(1.0), call("shape", x))));
+        }
+
+        // outer product of two vectors
+        ast::expression outer(
+            ast::expression const& x, ast::expression const& y)
+        {
+            return call("dot", call("add_dim", x),
+                call("transpose", call("add_dim", y)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct collect_variable_names
+        {
+            std::set<std::string>& names_;
+
+            template <typename Ast>
+            bool on_enter(Ast const&) const
+            {
+                return true;
+            }
+
+            bool on_enter(ast::identifier const& id) const
+            {
+                names_.insert(id.name);
+                return true;
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // primitives for which the generated code propagates adjoints
+        std::set<std::string> const& differentiable_primitives()
+        {
+            static std::set<std::string> const primitives = {
+                "__add", "__sub", "__mul", "__div", "__minus", "dot", "exp",
+                "log", "sqrt", "sin", "cos", "power", "sum", "mean",
+                "transpose", "slice"
+            };
+            return primitives;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        class reverse_mode
+        {
+            // One entry of the tape: either an intermediate value (result of
+            // a differentiable primitive) or a leaf (variable, literal, or
+            // an expression not depending on the variable of interest).
+            struct node
+            {
+                std::string primitive_;             // empty for leaves
+                std::vector<std::size_t> operands_;
+                std::vector<ast::expression> arguments_;  // non-differentiable
+                ast::expression value_;             // refers to the value
+                bool depends_ = false;              // depends on 'wrt'
+                bool has_adjoint_ = false;
+            };
+
+        public:
+            reverse_mode(std::string const& wrt,
+                    expression_pattern_list const& patterns,
+                    std::string const& codename)
+              : wrt_(wrt)
+              , patterns_(patterns)
+              , codename_(codename)
+            {}
+
+            ast::expression generate(ast::expression const& body)
+            {
+                std::size_t result = record(body);
+
+                auto it = leaves_.find(wrt_);
+                if (it == leaves_.end() || !nodes_[result].depends_)
+                {
+                    // the result does not depend on 'wrt' at all
+                    statements_.push_back(call("__mul",
+                        ast::expression(0.0), variable(wrt_)));
+                    return call("block", std::move(statements_));
+                }
+
+                // seed the backward sweep, the gradient of sum(result) is
+                // calculated for non-scalar results
+                accumulate(result,
+                    broadcast_like(ast::expression(1.0), value(result)));
+
+                for (std::size_t i = result + 1; i != 0; --i)
+                {
+                    if (nodes_[i - 1].has_adjoint_)
+                    {
+                        propagate(i - 1);
+                    }
+                }
+
+                statements_.push_back(adjoint(it->second));
+                return call("block", std::move(statements_));
+            }
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            [[noreturn]] void throw_error(
+                std::string const& msg, ast::expression const& expr) const
+            {
+                ast::tagged id = ast::detail::tagged_id(expr);
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::differentiate",
+                    hpx::util::format(
+                        PHYLANX_FORMAT_SPEC(1)
+                            "(" PHYLANX_FORMAT_SPEC(2) ", "
+                            PHYLANX_FORMAT_SPEC(3) "): " PHYLANX_FORMAT_SPEC(4),
+                        codename_, id.id, id.col, msg));
+            }
+
+            ast::expression const& value(std::size_t n) const
+            {
+                return nodes_[n].value_;
+            }
+
+            ast::expression adjoint(std::size_t n) const
+            {
+                return variable("__adjoint_" + std::to_string(n));
+            }
+
+            std::size_t add_node(node&& n)
+            {
+                nodes_.push_back(std::move(n));
+                return nodes_.size() - 1;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Find the primitive the expression refers to, extract its
+            // operands in the order they are passed to the primitive.
+            bool match(ast::expression const& expr, std::string& name,
+                std::vector<ast::expression>& operands) const
+            {
+                auto check = [&](expression_pattern_list::value_type const& p)
+                {
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<1>(p.second),
+                            ast::detail::on_placeholder_match{placeholders}))
+                    {
+                        return false;
+                    }
+
+                    name = p.first;
+                    operands.clear();
+                    for (auto const& placeholder : placeholders)
+                    {
+                        operands.push_back(placeholder.second);
+                    }
+                    return true;
+                };
+
+                if (ast::detail::is_function_call(expr))
+                {
+                    auto range =
+                        patterns_.equal_range(ast::detail::function_name(expr));
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (check(*it))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                for (auto const& p : patterns_)
+                {
+                    if (check(p))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Whether the given (opaque) expression refers to a value which
+            // depends on 'wrt'
+            bool depends_on_wrt(ast::expression const& expr) const
+            {
+                std::set<std::string> names;
+                ast::traverse(expr, collect_variable_names{names});
+                for (auto const& name : names)
+                {
+                    if (name == wrt_)
+                    {
+                        return true;
+                    }
+                    auto it = bindings_.find(name);
+                    if (it != bindings_.end() && nodes_[it->second].depends_)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::size_t record_leaf(ast::expression const& expr)
+            {
+                if (depends_on_wrt(expr))
+                {
+                    std::string name;
+                    std::vector<ast::expression> operands;
+                    if (match(expr, name, operands))
+                    {
+                        throw_error("grad: the primitive '" + name +
+                            "' is not differentiable", expr);
+                    }
+                    throw_error("grad: the expression '" +
+                        ast::to_string(expr) + "' is not differentiable", expr);
+                }
+
+                node n;
+                if (ast::detail::is_identifier(expr) ||
+                    (!ast::detail::is_function_call(expr) &&
+                        ast::detail::is_literal_value(expr)))
+                {
+                    n.value_ = expr;
+                }
+                else
+                {
+                    // evaluate the expression only once, all later uses
+                    // refer to its value on the tape
+                    std::string tape_name =
+                        "__tape_" + std::to_string(nodes_.size());
+                    statements_.push_back(
+                        call("define", variable(tape_name), expr));
+                    n.value_ = variable(tape_name);
+                }
+                return add_node(std::move(n));
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // forward sweep: record all intermediate values
+            std::size_t record(ast::expression const& expr)
+            {
+                if (ast::detail::is_identifier(expr))
+                {
+                    std::string name = ast::detail::identifier_name(expr);
+
+                    auto it = bindings_.find(name);
+                    if (it != bindings_.end())
+                    {
+                        return it->second;      // locally defined value
+                    }
+
+                    auto lit = leaves_.find(name);
+                    if (lit != leaves_.end())
+                    {
+                        return lit->second;
+                    }
+
+                    node n;
+                    n.value_ = variable(name);
+                    n.depends_ = (name == wrt_);
+                    std::size_t result = add_node(std::move(n));
+                    leaves_.emplace(std::move(name), result);
+                    return result;
+                }
+
+                if (!ast::detail::is_function_call(expr) &&
+                    ast::detail::is_literal_value(expr))
+                {
+                    node n;
+                    n.value_ = expr;
+                    return add_node(std::move(n));
+                }
+
+                if (ast::detail::is_function_call(expr))
+                {
+                    std::string name = ast::detail::function_name(expr);
+                    if (name == "block")
+                    {
+                        return record_block(expr);
+                    }
+                    if (name == "define")
+                    {
+                        throw_error("grad: define() is supported only as a "
+                            "statement of a block()", expr);
+                    }
+                }
+
+                std::string name;
+                std::vector<ast::expression> operands;
+                if (!match(expr, name, operands) ||
+                    differentiable_primitives().count(name) == 0)
+                {
+                    return record_leaf(expr);
+                }
+
+                // only the unary forms of the reductions are supported
+                if ((name == "sum" || name == "mean") && operands.size() != 1)
+                {
+                    return record_leaf(expr);
+                }
+
+                node n;
+                n.primitive_ = name;
+
+                std::vector<ast::expression> args;
+                for (std::size_t i = 0; i != operands.size(); ++i)
+                {
+                    // the indices of slice() are not differentiable
+                    if (name == "slice" && i != 0)
+                    {
+                        std::size_t index = record_leaf(operands[i]);
+                        n.arguments_.push_back(value(index));
+                        args.push_back(value(index));
+                        continue;
+                    }
+
+                    std::size_t operand = record(operands[i]);
+                    n.operands_.push_back(operand);
+                    n.depends_ = n.depends_ || nodes_[operand].depends_;
+                    args.push_back(value(operand));
+                }
+
+                // store the intermediate value on the tape
+                std::string tape_name =
+                    "__tape_" + std::to_string(nodes_.size());
+                statements_.push_back(call("define", variable(tape_name),
+                    call(name, std::move(args))));
+
+                n.value_ = variable(tape_name);
+                return add_node(std::move(n));
+            }
+
+            std::size_t record_block(ast::expression const& expr)
+            {
+                std::vector<ast::expression> args =
+                    ast::detail::function_arguments(expr);
+                if (args.empty())
+                {
+                    throw_error("grad: the function must return a value", expr);
+                }
+
+                for (std::size_t i = 0; i != args.size() - 1; ++i)
+                {
+                    ast::expression const& stmt = args[i];
+                    if (!ast::detail::is_function_call(stmt) ||
+                        ast::detail::function_name(stmt) != "define")
+                    {
+                        // statements whose value is not used are executed
+                        // once on the tape
+                        record_leaf(stmt);
+                        continue;
+                    }
+
+                    std::vector<ast::expression> define_args =
+                        ast::detail::function_arguments(stmt);
+                    if (define_args.size() != 2 ||
+                        !ast::detail::is_identifier(define_args[0]))
+                    {
+                        throw_error("grad: only variables can be defined in "
+                            "a function to differentiate", stmt);
+                    }
+
+                    std::string name =
+                        ast::detail::identifier_name(define_args[0]);
+                    std::size_t value_node = record(define_args[1]);
+
+                    // make the variable visible to expressions which are
+                    // evaluated as they are
+                    statements_.push_back(call("define",
+                        variable(name), value(value_node)));
+                    bindings_[name] = value_node;
+                }
+
+                return record(args.back());
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // backward sweep: accumulate the adjoints
+            void accumulate(std::size_t n, ast::expression&& contribution)
+            {
+                if (!nodes_[n].depends_)
+                {
+                    return;
+                }
+
+                if (!nodes_[n].has_adjoint_)
+                {
+                    nodes_[n].has_adjoint_ = true;
+                    statements_.push_back(call("define", adjoint(n),
+                        std::move(contribution)));
+                }
+                else
+                {
+                    statements_.push_back(call("store", adjoint(n),
+                        call("__add", adjoint(n), std::move(contribution))));
+                }
+            }
+
+            void propagate(std::size_t k)
+            {
+                node const& n = nodes_[k];
+                if (n.primitive_.empty())
+                {
+                    return;
+                }
+
+                std::vector<std::size_t> const operands = n.operands_;
+                std::string const primitive = n.primitive_;
+
+                ast::expression g = adjoint(k);
+                ast::expression v = value(k);
+
+                if (primitive == "__add")
+                {
+                    for (std::size_t op : operands)
+                    {
+                        accumulate(op, unbroadcast(g, value(op)));
+                    }
+                }
+                else if (primitive == "__sub")
+                {
+                    accumulate(operands[0], unbroadcast(g, value(operands[0])));
+                    for (std::size_t i = 1; i != operands.size(); ++i)
+                    {
+                        accumulate(operands[i], unbroadcast(
+                            call("__minus", g), value(operands[i])));
+                    }
+                }
+                else if (primitive == "__mul")
+                {
+                    for (std::size_t i = 0; i != operands.size(); ++i)
+                    {
+                        std::vector<ast::expression> factors{g};
+                        for (std::size_t j = 0; j != operands.size(); ++j)
+                        {
+                            if (i != j)
+                            {
+                                factors.push_back(value(operands[j]));
+                            }
+                        }
+                        accumulate(operands[i], unbroadcast(
+                            call("__mul", std::move(factors)),
+                            value(operands[i])));
+                    }
+                }
+                else if (primitive == "__div")
+                {
+                    // a / b / c ...: the adjoint of a is g / (b * c * ...),
+                    // the adjoint of b is -g * v / b, etc.
+                    std::vector<ast::expression> divisors;
+                    for (std::size_t i = 1; i != operands.size(); ++i)
+                    {
+                        divisors.push_back(value(operands[i]));
+                    }
+                    ast::expression denominator = divisors.size() == 1 ?
+                        divisors[0] : call("__mul", std::move(divisors));
+
+                    accumulate(operands[0], unbroadcast(
+                        call("__div", g, std::move(denominator)),
+                        value(operands[0])));
+                    for (std::size_t i = 1; i != operands.size(); ++i)
+                    {
+                        accumulate(operands[i], unbroadcast(
+                            call("__minus", call("__div",
+                                call("__mul", g, v), value(operands[i]))),
+                            value(operands[i])));
+                    }
+                }
+                else if (primitive == "__minus")
+                {
+                    accumulate(operands[0], call("__minus", g));
+                }
+                else if (primitive == "dot")
+                {
+                    ast::expression a = value(operands[0]);
+                    ast::expression b = value(operands[1]);
+
+                    // matrix x vector: outer(g, b), vector x vector: g * b,
+                    // otherwise dot(g, transpose(b))
+                    accumulate(operands[0],
+                        if_(ndim_equals(b, 1),
+                            if_(ndim_equals(a, 2), outer(g, b),
+                                call("__mul", g, b)),
+                            call("dot", g, call("transpose", b))));
+
+                    // vector x matrix: outer(a, g), vector x vector: g * a,
+                    // otherwise dot(transpose(a), g)
+                    accumulate(operands[1],
+                        if_(ndim_equals(a, 1),
+                            if_(ndim_equals(b, 2), outer(a, g),
+                                call("__mul", g, a)),
+                            call("dot", call("transpose", a), g)));
+                }
+                else if (primitive == "exp")
+                {
+                    accumulate(operands[0], call("__mul", g, v));
+                }
+                else if (primitive == "log")
+                {
+                    accumulate(operands[0],
+                        call("__div", g, value(operands[0])));
+                }
+                else if (primitive == "sqrt")
+                {
+                    accumulate(operands[0], call("__div", g,
+                        call("__mul", ast::expression(2.0), v)));
+                }
+                else if (primitive == "sin")
+                {
+                    accumulate(operands[0],
+                        call("__mul", g, call("cos", value(operands[0]))));
+                }
+                else if (primitive == "cos")
+                {
+                    accumulate(operands[0], call("__minus",
+                        call("__mul", g, call("sin", value(operands[0])))));
+                }
+                else if (primitive == "power")
+                {
+                    ast::expression x = value(operands[0]);
+                    ast::expression y = value(operands[1]);
+
+                    accumulate(operands[0], unbroadcast(
+                        call("__mul", std::vector<ast::expression>{g, y,
+                            call("power", x,
+                                call("__sub", y, ast::expression(1.0)))}),
+                        x));
+                    accumulate(operands[1], unbroadcast(
+                        call("__mul", std::vector<ast::expression>{
+                            g, v, call("log", x)}),
+                        y));
+                }
+                else if (primitive == "sum")
+                {
+                    accumulate(operands[0],
+                        broadcast_like(g, value(operands[0])));
+                }
+                else if (primitive == "mean")
+                {
+                    ast::expression x = value(operands[0]);
+                    accumulate(operands[0],
+                        call("__div", broadcast_like(g, x), size(x)));
+                }
+                else if (primitive == "transpose")
+                {
+                    accumulate(operands[0], call("transpose", g));
+                }
+                else if (primitive == "slice")
+                {
+                    // scatter the adjoint into an array of zeros
+                    ast::expression x = value(operands[0]);
+                    ast::expression scattered =
+                        variable("__scatter_" + std::to_string(k));
+
+                    statements_.push_back(call("define", scattered,
+                        call("constant", ast::expression(0.0),
+                            call("shape", x))));
+
+                    std::vector<ast::expression> args{scattered};
+                    for (auto const& arg : nodes_[k].arguments_)
+                    {
+                        args.push_back(arg);
+                    }
+                    statements_.push_back(call("store",
+                        call("slice", std::move(args)), g));
+
+                    accumulate(operands[0], std::move(scattered));
+                }
+            }
+
+        private:
+            std::string wrt_;
+            expression_pattern_list const& patterns_;
+            std::string codename_;
+
+            std::vector<node> nodes_;
+            std::map<std::string, std::size_t> leaves_;     // variables
+            std::map<std::string, std::size_t> bindings_;   // local define()s
+            std::vector<ast::expression> statements_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ast::expression differentiate(ast::expression const& body,
+        std::string const& wrt, expression_pattern_list const& patterns,
+        std::string const& codename)
+    {
+        // the tape is shared by all invocations of the gradient function,
+        // concurrent invocations are therefore serialized
+        return detail::call("critical",
+            detail::reverse_mode(wrt, patterns, codename).generate(body));
+    }
+}}}
@@ -15,21 +15,27 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/match_ast.hpp>
 #include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/autodiff.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/placement.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/ir/node_data.hpp>
 
 #include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/runtime/config_entry.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <utility>
@@ -81,6 +87,181 @@ namespace phylanx { namespace execution_tree { namespace compiler
         return result;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Read and write sets of the variables referenced by one statement
+        // of a block(). Statements which may have side effects we can't
+        // see (calls to user defined functions, I/O, etc.) act as barriers.
+        struct statement_dependencies
+        {
+            std::set<std::string> reads_;
+            std::set<std::string> writes_;
+            bool has_side_effects_ = false;
+
+            bool depends_on(statement_dependencies const& rhs) const
+            {
+                if (has_side_effects_ || rhs.has_side_effects_)
+                {
+                    return true;
+                }
+                return intersects(writes_, rhs.writes_) ||
+                    intersects(writes_, rhs.reads_) ||
+                    intersects(reads_, rhs.writes_);
+            }
+
+        private:
+            static bool intersects(std::set<std::string> const& lhs,
+                std::set<std::string> const& rhs)
+            {
+                auto lit = lhs.begin();
+                auto rit = rhs.begin();
+                while (lit != lhs.end() && rit != rhs.end())
+                {
+                    if (*lit < *rit)
+                    {
+                        ++lit;
+                    }
+                    else if (*rit < *lit)
+                    {
+                        ++rit;
+                    }
+                    else
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+
+        // built-in primitives that are observable in a way not reflected by
+        // the variables they reference
+        bool has_builtin_side_effects(std::string const& name)
+        {
+            static std::set<std::string> const side_effects =
+            {
+                "assert", "cout", "debug", "enable_tracing",
+                "file_read", "file_read_csv", "file_read_hdf5",
+                "file_write", "file_write_csv", "file_write_hdf5",
+                "random", "set_seed", "shuffle"
+            };
+            return side_effects.find(name) != side_effects.end();
+        }
+
+        struct collect_identifiers
+        {
+            std::set<std::string>& names_;
+
+            template <typename Ast>
+            bool on_enter(Ast const&) const
+            {
+                return true;
+            }
+
+            bool on_enter(ast::identifier const& id) const
+            {
+                names_.insert(id.name);
+                return true;
+            }
+        };
+
+        struct collect_statement_dependencies
+        {
+            environment& env_;
+            statement_dependencies& deps_;
+
+            template <typename Ast>
+            bool on_enter(Ast const&) const
+            {
+                return !deps_.has_side_effects_;
+            }
+
+            bool on_enter(ast::identifier const& id) const
+            {
+                if (id.name == "nil" || id.name == "true" ||
+                    id.name == "false")
+                {
+                    return true;
+                }
+
+                // referring to a user defined function by name may invoke it
+                // from somewhere we can't see
+                compiled_function* cf = env_.find(id.name);
+                if (cf != nullptr)
+                {
+                    auto at = cf->target<access_target>();
+                    if (at != nullptr && at->target_name_ == "access-function")
+                    {
+                        deps_.has_side_effects_ = true;
+                        return false;
+                    }
+                }
+
+                deps_.reads_.insert(id.name);
+                return true;
+            }
+
+            bool on_enter(ast::function_call const& fc) const
+            {
+                std::string const& name = fc.function_name.name;
+                if (name == "define")
+                {
+                    if (!fc.args.empty() &&
+                        ast::detail::is_identifier(fc.args[0]))
+                    {
+                        deps_.writes_.insert(
+                            ast::detail::identifier_name(fc.args[0]));
+                    }
+                    return true;
+                }
+
+                if (name == "store")
+                {
+                    if (!fc.args.empty())
+                    {
+                        ast::traverse(fc.args[0],
+                            collect_identifiers{deps_.writes_});
+                    }
+                    return true;
+                }
+
+                // calling anything but a built-in function could have
+                // arbitrary side effects
+                compiled_function* cf = env_.find(name);
+                if (cf == nullptr || cf->target<builtin_function>() == nullptr ||
+                    has_builtin_side_effects(name))
+                {
+                    deps_.has_side_effects_ = true;
+                    return false;
+                }
+                return true;
+            }
+        };
+
+        bool auto_parallel_block()
+        {
+            static bool auto_parallel_block =
+                hpx::get_config_entry("phylanx.auto_parallel_block", "0") ==
+                "1";
+            return auto_parallel_block;
+        }
+
+        bool fuse_where()
+        {
+            static bool fuse_where =
+                hpx::get_config_entry("phylanx.fuse_where", "1") == "1";
+            return fuse_where;
+        }
+
+        bool placement()
+        {
+            static bool placement =
+                hpx::get_config_entry("phylanx.placement", "1") == "1";
+            return placement;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct compiler
     {
@@ -251,12 +432,140 @@ namespace phylanx { namespace execution_tree { namespace compiler
             return last->second;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // on_locality(n, expr) compiles 'expr' such that its primitives are
+        // created on the locality with the id 'n'
+        bool is_locality_annotation(ast::expression const& expr) const
+        {
+            return ast::detail::is_function_call(expr) &&
+                ast::detail::function_name(expr) == "on_locality";
+        }
+
+        ast::expression extract_locality_annotation(
+            ast::expression const& expr, hpx::id_type& locality) const
+        {
+            ast::tagged id = ast::detail::tagged_id(expr);
+
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(expr);
+            if (args.size() != 2 || !ast::detail::is_literal_value(args[0]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::"
+                        "extract_locality_annotation",
+                    generate_error_message(
+                        "the on_locality() annotation requires exactly two "
+                        "arguments, the first of which must be a literal "
+                        "locality id",
+                        name_, id));
+            }
+
+            std::int64_t locality_id = extract_scalar_integer_value(
+                to_primitive_value_type(ast::detail::literal_value(args[0])),
+                name_, name_);
+
+            std::uint32_t num_localities =
+                hpx::get_num_localities(hpx::launch::sync);
+            if (locality_id < 0 ||
+                locality_id >= std::int64_t(num_localities))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::"
+                        "extract_locality_annotation",
+                    generate_error_message(hpx::util::format(
+                        "the on_locality() annotation refers to a "
+                        "non-existing locality (" PHYLANX_FORMAT_SPEC(1)
+                        "), the number of localities is "
+                        PHYLANX_FORMAT_SPEC(2),
+                        locality_id, num_localities), name_, id));
+            }
+
+            locality = hpx::naming::get_id_from_locality_id(
+                std::uint32_t(locality_id));
+            return args[1];
+        }
+
+        function handle_locality_annotation(ast::expression const& expr)
+        {
+            hpx::id_type locality;
+            ast::expression body = extract_locality_annotation(expr, locality);
+            return compile(name_, body, snippets_, env_, patterns_, locality);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Place a built-in primitive on the locality which holds most of its
+        // operands to avoid shipping their values when it is evaluated.
+        hpx::id_type select_locality(std::list<function> const& args) const
+        {
+            std::map<std::uint32_t, std::size_t> votes;
+            for (auto const& arg : args)
+            {
+                std::uint32_t locality = operand_locality(arg.arg_);
+                if (locality != hpx::naming::invalid_locality_id)
+                {
+                    ++votes[locality];
+                }
+            }
+
+            std::uint32_t default_id =
+                hpx::naming::get_locality_id_from_id(default_locality_);
+
+            std::uint32_t best = default_id;
+            std::size_t best_votes = votes[default_id];
+            for (auto const& vote : votes)
+            {
+                if (vote.second > best_votes)
+                {
+                    best = vote.first;
+                    best_votes = vote.second;
+                }
+            }
+
+            if (best == default_id)
+            {
+                return default_locality_;
+            }
+            return hpx::naming::get_id_from_locality_id(best);
+        }
+
+        void record_placement(std::string name, hpx::id_type const& locality,
+            std::list<function> const& args) const
+        {
+            placement_entry entry{std::move(name),
+                hpx::naming::get_locality_id_from_id(locality), args.size(),
+                0, 0};
+
+            bool is_local = locality == hpx::find_here();
+            for (auto const& arg : args)
+            {
+                std::uint32_t arg_locality = operand_locality(arg.arg_);
+                if (arg_locality != hpx::naming::invalid_locality_id)
+                {
+                    if (arg_locality != entry.locality)
+                    {
+                        ++entry.remote_operands;
+                    }
+                }
+                else if (!is_local)
+                {
+                    entry.literal_bytes += literal_operand_size(arg.arg_);
+                }
+            }
+
+            snippets_.placement_.entries.push_back(std::move(entry));
+        }
+
         ///////////////////////////////////////////////////////////////////////
         function compile_body(ast::expression const& body) const
+        {
+            return compile_body(body, default_locality_);
+        }
+
+        function compile_body(ast::expression const& body,
+            hpx::id_type const& locality) const
         {
             environment env(&env_);
-            return compile(
-                name_, body, snippets_, env, patterns_, default_locality_);
+            return compile(name_, body, snippets_, env, patterns_, locality);
         }
 
         function compile_body(
@@ -348,14 +657,22 @@ namespace phylanx { namespace execution_tree { namespace compiler
             primitive_name_parts name_parts;
             if (args.empty())
             {
+                // define(x, on_locality(n, body)) places the variable (and
+                // all accesses to it) on the locality 'n'
+                hpx::id_type locality = default_locality_;
+                if (is_locality_annotation(body))
+                {
+                    body = extract_locality_annotation(body, locality);
+                }
+
                 // get global name of the component created
 
                 compiled_function* cf = env_.define(name,
-                    access_target(f, "access-variable", default_locality_));
+                    access_target(f, "access-variable", locality));
 
                 // Correct type of the access object if this variable refers
                 // to a lambda.
-                auto body_f = compile_body(body);
+                auto body_f = compile_body(body, locality);
                 primitive_name_parts body_name_parts;
                 if (parse_primitive_name(body_f.name_, body_name_parts) &&
                     body_name_parts.primitive == "lambda")
@@ -381,7 +698,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 std::string variable_name = compose_primitive_name(name_parts);
                 f = function{primitive_argument_type{
                         create_primitive_component(
-                            default_locality_, name_parts.primitive,
+                            locality, name_parts.primitive,
                             primitive_argument_type{}, variable_name, name_)
                     }, variable_name};
 
@@ -407,6 +724,11 @@ namespace phylanx { namespace execution_tree { namespace compiler
                             primitive_argument_type{}, variable_name, name_)
                     }, variable_name};
 
+                // keep the definition for later source transformations, it
+                // is identified by the (unique) name of the function object
+                snippets_.function_definitions_[variable_name] =
+                    std::make_pair(args, body);
+
                 auto var = primitive_operand(f.arg_, variable_name, name_);
                 var.store(hpx::launch::sync,
                     std::move(compile_lambda(args, body, id).arg_), {});
@@ -425,6 +747,95 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 std::move(variable_ref.arg_), std::move(name_parts), name_);
         }
 
+        // grad(f, x) generates a function calculating the gradient of the
+        // function f with respect to its argument x
+        function handle_grad(
+            std::multimap<std::string, ast::expression>& placeholders,
+            ast::tagged const& grad_id)
+        {
+            // we know that 'grad()' uses '_1' and '_2' to match arguments
+            ast::expression const& func = placeholders.find("_1")->second;
+            ast::expression const& wrt = placeholders.find("_2")->second;
+
+            if (!ast::detail::is_identifier(wrt))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_grad",
+                    generate_error_message(
+                        "the grad() operation requires that the variable to "
+                        "differentiate with respect to is represented as a "
+                        "variable name (not an expression)",
+                        name_, grad_id));
+            }
+
+            std::vector<ast::expression> args;
+            ast::expression body;
+            if (ast::detail::is_function_call(func) &&
+                ast::detail::function_name(func) == "lambda")
+            {
+                args = ast::detail::function_arguments(func);
+                if (!args.empty())
+                {
+                    body = args.back();
+                    args.pop_back();
+                }
+            }
+            else if (ast::detail::is_identifier(func))
+            {
+                // look up the function visible in the current scope
+                auto it = snippets_.function_definitions_.end();
+                if (compiled_function* cf =
+                        env_.find(ast::detail::identifier_name(func)))
+                {
+                    access_target const* at = cf->target<access_target>();
+                    if (at != nullptr)
+                    {
+                        it = snippets_.function_definitions_.find(
+                            at->f_.get().name_);
+                    }
+                }
+                if (it == snippets_.function_definitions_.end())
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::compiler::handle_grad",
+                        generate_error_message(
+                            "the grad() operation requires the name of a "
+                            "function defined using define() (or a lambda)",
+                            name_, grad_id));
+                }
+                args = it->second.first;
+                body = it->second.second;
+            }
+            else
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_grad",
+                    generate_error_message(
+                        "the grad() operation requires a lambda or the name "
+                        "of a function as its first argument",
+                        name_, grad_id));
+            }
+
+            std::string wrt_name = ast::detail::identifier_name(wrt);
+            auto it = std::find_if(args.begin(), args.end(),
+                [&](ast::expression const& arg)
+                {
+                    return ast::detail::identifier_name(arg) == wrt_name;
+                });
+            if (it == args.end())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_grad",
+                    generate_error_message(
+                        "the grad() operation requires that '" + wrt_name +
+                            "' is an argument of the function to differentiate",
+                        name_, grad_id));
+            }
+
+            return compile_lambda(args,
+                differentiate(body, wrt_name, patterns_, name_), grad_id);
+        }
+
         bool handle_sliced_variable_reference(std::string name,
             ast::expression const& expr, std::list<function>&& elements,
             function& result)
@@ -598,6 +1009,115 @@ namespace phylanx { namespace execution_tree { namespace compiler
                     name_, id));
         }
 
+        // Group the statements of a block() such that each group contains
+        // only statements that are independent of each other. Groups with
+        // more than one statement are wrapped into a parallel_block(). The
+        // last statement is kept last as it provides the value of the block.
+        std::list<function> schedule_block_statements(
+            std::multimap<std::string, ast::expression> const& placeholders,
+            std::list<function>&& args, environment& env, ast::tagged id)
+        {
+            std::vector<detail::statement_dependencies> deps;
+            deps.reserve(placeholders.size());
+
+            for (auto const& placeholder : placeholders)
+            {
+                deps.emplace_back();
+                ast::traverse(placeholder.second,
+                    detail::collect_statement_dependencies{env, deps.back()});
+            }
+
+            // a statement has to run after all earlier statements it
+            // depends on
+            std::size_t size = deps.size() - 1;
+            std::vector<std::size_t> levels(size, 0);
+            std::size_t num_levels = 0;
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                for (std::size_t j = 0; j != i; ++j)
+                {
+                    if (levels[j] >= levels[i] && deps[i].depends_on(deps[j]))
+                    {
+                        levels[i] = levels[j] + 1;
+                    }
+                }
+                num_levels = (std::max)(num_levels, levels[i] + 1);
+            }
+
+            if (num_levels == size)
+            {
+                return std::move(args);     // nothing to run concurrently
+            }
+
+            std::vector<std::list<function>> groups(num_levels);
+            auto it = args.begin();
+            for (std::size_t i = 0; i != size; ++i, ++it)
+            {
+                groups[levels[i]].push_back(std::move(*it));
+            }
+
+            std::list<function> result;
+            compiled_function* cf = env_.find("parallel_block");
+            for (auto& group : groups)
+            {
+                if (group.size() == 1 || cf == nullptr)
+                {
+                    result.splice(result.end(), group);
+                    continue;
+                }
+
+                static std::string parallel_block_("parallel_block");
+                primitive_name_parts name_parts(parallel_block_,
+                    snippets_.sequence_numbers_[parallel_block_]++, id.id,
+                    id.col, snippets_.compile_id_ - 1);
+
+                result.push_back(
+                    (*cf)(std::move(group), std::move(name_parts), name_));
+            }
+            result.push_back(std::move(args.back()));
+
+            return result;
+        }
+
+        // Map where(lhs <op> rhs, a, b) onto the corresponding fused
+        // compare-and-select primitive, this avoids creating the boolean
+        // condition as an intermediate array.
+        bool handle_fused_where(ast::expression const& expr, ast::tagged id,
+            function& result)
+        {
+            static char const* const fused_names[] =
+            {
+                "__where_eq", "__where_ne", "__where_lt",
+                "__where_le", "__where_gt", "__where_ge"
+            };
+
+            for (char const* name : fused_names)
+            {
+                auto range = patterns_.equal_range(name);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    ast::expression const& pattern =
+                        hpx::util::get<1>((*it).second);
+
+                    // only the patterns spelled as where(...) are relevant
+                    if (!ast::detail::is_function_call(pattern) ||
+                        ast::detail::function_name(pattern) != "where")
+                    {
+                        continue;
+                    }
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (ast::match_ast(expr, pattern,
+                            ast::detail::on_placeholder_match{placeholders}))
+                    {
+                        result = handle_placeholders(placeholders, name, id);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
         function handle_placeholders(
             std::multimap<std::string, ast::expression>& placeholders,
             std::string const& name, ast::tagged id)
@@ -630,9 +1150,34 @@ namespace phylanx { namespace execution_tree { namespace compiler
                         args.push_back(compile(name_, placeholder.second,
                             snippets_, env, patterns_, default_locality_));
                     }
+
+                    // run independent statements of a block concurrently
+                    if (name == "block" && args.size() > 2 &&
+                        detail::auto_parallel_block())
+                    {
+                        args = schedule_block_statements(
+                            placeholders, std::move(args), env, id);
+                    }
                 }
 
-                // create primitive with given arguments
+                // create primitive with given arguments on the locality
+                // holding most of its operands
+                builtin_function const* bf = cf->target<builtin_function>();
+                if (bf != nullptr && detail::placement())
+                {
+                    hpx::id_type locality = select_locality(args);
+                    if (snippets_.placement_.enabled)
+                    {
+                        record_placement(
+                            compose_primitive_name(name_parts), locality, args);
+                    }
+
+                    if (locality != bf->locality())
+                    {
+                        return bf->placed_on(locality)(
+                            std::move(args), std::move(name_parts), name_);
+                    }
+                }
                 return (*cf)(std::move(args), std::move(name_parts), name_);
             }
 
@@ -653,6 +1198,12 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 // handle function calls separately
                 std::string function_name = ast::detail::function_name(expr);
 
+                // Handle on_locality(_1, _2)
+                if (function_name == "on_locality")
+                {
+                    return handle_locality_annotation(expr);
+                }
+
                 expression_pattern_list::const_iterator cit =
                     patterns_.lower_bound(function_name);
                 if (cit != patterns_.end())
@@ -679,6 +1230,17 @@ namespace phylanx { namespace execution_tree { namespace compiler
                         }
                     }
 
+                    // Handle grad(_1, _2)
+                    if (function_name == "grad")
+                    {
+                        std::multimap<std::string, ast::expression> placeholders;
+                        if (ast::match_ast(expr, hpx::util::get<1>((*cit).second),
+                                ast::detail::on_placeholder_match{placeholders}))
+                        {
+                            return handle_grad(placeholders, id);
+                        }
+                    }
+
                     // Handle slice(_1, __2)
                     if (function_name == "slice")
                     {
@@ -699,6 +1261,16 @@ namespace phylanx { namespace execution_tree { namespace compiler
                         }
                     }
 
+                    // Handle where(_1 <op> _2, _3, _4)
+                    if (function_name == "where" && detail::fuse_where())
+                    {
+                        function where_result;
+                        if (handle_fused_where(expr, id, where_result))
+                        {
+                            return where_result;
+                        }
+                    }
+
                     // handle all non-special functions
                     while (cit != patterns_.end() && (*cit).first == function_name)
                     {
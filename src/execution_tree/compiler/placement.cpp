@@ -0,0 +1,121 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/placement.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t placement_report::cross_locality_operands() const
+    {
+        std::size_t result = 0;
+        for (auto const& entry : entries)
+        {
+            result += entry.remote_operands;
+        }
+        return result;
+    }
+
+    std::size_t placement_report::shipped_literal_bytes() const
+    {
+        std::size_t result = 0;
+        for (auto const& entry : entries)
+        {
+            result += entry.literal_bytes;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint32_t operand_locality(primitive_argument_type const& operand)
+    {
+        primitive const* p = util::get_if<primitive>(&operand);
+        if (p == nullptr || !p->valid())
+        {
+            return hpx::naming::invalid_locality_id;
+        }
+
+        // primitives are not migrated, their ids encode the locality they
+        // were created on
+        return hpx::naming::get_locality_id_from_id(p->get_id());
+    }
+
+    std::size_t literal_operand_size(primitive_argument_type const& operand)
+    {
+        switch (operand.index())
+        {
+        case 1:     // node_data<std::uint8_t>
+            return util::get<1>(operand).size() * sizeof(std::uint8_t);
+
+        case 2:     // node_data<std::int64_t>
+            return util::get<2>(operand).size() * sizeof(std::int64_t);
+
+        case 3:     // std::string
+            return util::get<3>(operand).size();
+
+        case 4:     // node_data<double>
+            return util::get<4>(operand).size() * sizeof(double);
+
+        case 7:     // ir::range
+            {
+                std::size_t result = 0;
+                for (auto const& elem : util::get<7>(operand))
+                {
+                    result += literal_operand_size(elem);
+                }
+                return result;
+            }
+
+        default:
+            break;
+        }
+        return 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string format_placement_report(placement_report const& report)
+    {
+        std::map<std::uint32_t, std::size_t> primitives;
+        for (auto const& entry : report.entries)
+        {
+            ++primitives[entry.locality];
+        }
+
+        std::ostringstream strm;
+        strm << "placed primitives: " << report.entries.size() << "\n";
+        for (auto const& p : primitives)
+        {
+            strm << "  locality#" << p.first << ": " << p.second << "\n";
+        }
+        strm << "cross-locality operands: "
+             << report.cross_locality_operands() << "\n";
+        strm << "shipped literal bytes: "
+             << report.shipped_literal_bytes() << "\n";
+
+        for (auto const& entry : report.entries)
+        {
+            if (entry.remote_operands != 0)
+            {
+                strm << "  " << entry.name << " (locality#" << entry.locality
+                     << "): " << entry.remote_operands << " of "
+                     << entry.operands << " operands are remote\n";
+            }
+        }
+        return strm.str();
+    }
+}}}
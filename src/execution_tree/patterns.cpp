@@ -110,6 +110,7 @@ namespace phylanx { namespace execution_tree
                 PHYLANX_MATCH_DATA(assert_condition),
 
                 // special purpose primitives
+                PHYLANX_MATCH_DATA(critical_section),
                 PHYLANX_MATCH_DATA(store_operation),
 
                 // compiler-specific (internal) primitives
@@ -121,6 +122,7 @@ namespace phylanx { namespace execution_tree
                 PHYLANX_MATCH_DATA(access_variable),
                 PHYLANX_MATCH_DATA(define_variable),
                 PHYLANX_MATCH_DATA_VERBATIM(define_variable::match_data_define),
+                PHYLANX_MATCH_DATA_VERBATIM(define_variable::match_data_grad),
                 PHYLANX_MATCH_DATA(function),
                 PHYLANX_MATCH_DATA(lambda),
                 PHYLANX_MATCH_DATA(variable)
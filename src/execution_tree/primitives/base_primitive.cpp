@@ -21,6 +21,7 @@
 #include <hpx/include/async.hpp>
 #include <hpx/include/components.hpp>
 #include <hpx/include/sync.hpp>
+#include <hpx/runtime/find_here.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/util/logging.hpp>
 
@@ -2550,6 +2551,66 @@ namespace phylanx { namespace execution_tree
         return false;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool is_partitioned_operand(primitive_argument_type const& val)
+    {
+        // list("__partitioned", ...), see the dist_matrixops plugin
+        ir::range const* r = util::get_if<ir::range>(&val);
+        if (r == nullptr || r->empty())
+        {
+            return false;
+        }
+
+        std::string const* tag = util::get_if<std::string>(&*r->begin());
+        return tag != nullptr && *tag == "__partitioned";
+    }
+
+    bool any_partitioned_operand(primitive_arguments_type const& vals)
+    {
+        for (auto const& val : vals)
+        {
+            if (is_partitioned_operand(val))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    primitive_argument_type partitioned_operation(std::string const& type,
+        primitive_arguments_type&& vals, std::string const& codename)
+    {
+        if (vals.size() <= 2)
+        {
+            // the distributed primitive is anonymous as it is created on each
+            // evaluation, registering its name would cause clashes
+            primitive op = create_primitive_component(
+                hpx::find_here(), type, std::move(vals), "", codename);
+            return op.eval(hpx::launch::sync);
+        }
+
+        primitive_argument_type result = std::move(vals[0]);
+        for (std::size_t i = 1; i != vals.size(); ++i)
+        {
+            result = partitioned_operation(
+                type, std::move(result), std::move(vals[i]), codename);
+        }
+        return result;
+    }
+
+    primitive_argument_type partitioned_operation(std::string const& type,
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+        std::string const& codename)
+    {
+        primitive_arguments_type vals;
+        vals.reserve(2);
+        vals.emplace_back(std::move(lhs));
+        vals.emplace_back(std::move(rhs));
+
+        return partitioned_operation(type, std::move(vals), codename);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
     bool is_dictionary_operand(primitive_argument_type const& val)
     {
         switch (val.index())
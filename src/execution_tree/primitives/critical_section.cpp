@@ -0,0 +1,88 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/critical_section.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    primitive create_critical_section(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+    {
+        static std::string type("critical");
+        return create_primitive_component(
+            locality, type, std::move(operands), name, codename);
+    }
+
+    match_pattern_type const critical_section::match_data =
+    {
+        hpx::util::make_tuple("critical",
+            std::vector<std::string>{"critical(_1)"},
+            &create_critical_section, &create_primitive<critical_section>,
+            "expr\n"
+            "Args:\n"
+            "\n"
+            "    expr (expression) : the expression to evaluate\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The value of `expr`. Concurrent evaluations of the same "
+            "critical() expression are executed one after the other.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    critical_section::critical_section(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    hpx::future<primitive_argument_type> critical_section::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 1 || !valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "critical_section::eval",
+                generate_error_message(
+                    "the critical primitive requires exactly one valid "
+                    "operand"));
+        }
+
+        // The lock is held until the expression has been evaluated
+        // completely. The result is copied as it might refer to the data of
+        // a variable which is overwritten by the next evaluation.
+        std::lock_guard<mutex_type> l(mtx_);
+        return hpx::make_ready_future(extract_copy_value(
+            value_operand_sync(operands[0], args, name_, codename_),
+            name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> critical_section::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
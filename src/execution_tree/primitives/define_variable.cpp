@@ -65,6 +65,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
             )
     };
 
+    match_pattern_type const define_variable::match_data_grad =
+    {
+        hpx::util::make_tuple("grad",
+            std::vector<std::string>{"grad(_1, _2)"},
+            nullptr, nullptr,
+            "f, x\n"
+            "Args:\n"
+            "\n"
+            "    f (function): a lambda or the name of a function defined "
+            "using define()\n"
+            "    x (symbol): the argument of `f` to differentiate with "
+            "respect to\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "A function object taking the same arguments as `f` which "
+            "returns the gradient of `f` with respect to `x` (calculated "
+            "using reverse mode automatic differentiation). Supported are "
+            "the arithmetic operations, dot, exp, log, sqrt, sin, cos, "
+            "power, sum, mean, transpose, and slice."
+            )
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     define_variable::define_variable(
             primitive_arguments_type&& operands,
@@ -183,9 +183,36 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return primitive_->get_direct_execution(reset);
     }
 
-    void primitive_component::enable_measurements()
+    std::int64_t primitive_component::get_allocated_bytes(bool reset) const
     {
-        primitive_->enable_measurements();
+        return primitive_->get_allocated_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_largest_result_bytes(bool reset) const
+    {
+        return primitive_->get_largest_result_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_copy_count(bool reset) const
+    {
+        return primitive_->get_copy_count(reset);
+    }
+
+    std::int64_t primitive_component::get_size_class_eval_count(
+        std::size_t size_class, bool reset) const
+    {
+        return primitive_->get_size_class_eval_count(size_class, reset);
+    }
+
+    std::int64_t primitive_component::get_size_class_eval_duration(
+        std::size_t size_class, bool reset) const
+    {
+        return primitive_->get_size_class_eval_duration(size_class, reset);
+    }
+
+    void primitive_component::enable_measurements(bool size_histogram)
+    {
+        primitive_->enable_measurements(size_histogram);
     }
 
     hpx::launch primitive_component::select_direct_execution(
@@ -7,17 +7,23 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/eval_trace.hpp>
 #include <phylanx/util/scoped_timer.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -39,7 +45,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
       , eval_count_(0ll)
       , eval_duration_(0ll)
       , execute_directly_(eval_direct ? 1 : -1)
+      , allocated_bytes_(0ll)
+      , largest_result_bytes_(0ll)
+      , copy_count_(0ll)
       , measurements_enabled_(false)
+      , trace_name_(nullptr)
     {
 #if defined(HPX_HAVE_APEX)
         eval_name_ = name_ + "::eval";
@@ -69,6 +79,251 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::forward<T>(t));
     }
 
+    namespace detail
+    {
+        template <typename T>
+        std::int64_t allocated_bytes(ir::node_data<T> const* nd)
+        {
+            if (nd == nullptr || nd->is_ref())
+            {
+                return 0;
+            }
+            return static_cast<std::int64_t>(nd->size() * sizeof(T));
+        }
+
+        // number of bytes owned by the given value (references to data held
+        // by other values are not counted)
+        std::int64_t allocated_bytes(primitive_argument_type const& val)
+        {
+            return allocated_bytes(
+                    util::get_if<ir::node_data<double>>(&val)) +
+                allocated_bytes(
+                    util::get_if<ir::node_data<std::int64_t>>(&val)) +
+                allocated_bytes(
+                    util::get_if<ir::node_data<std::uint8_t>>(&val));
+        }
+    }
+
+    hpx::future<primitive_argument_type>
+    primitive_component_base::account_memory(
+        hpx::future<primitive_argument_type>&& f) const
+    {
+        auto record = [this](primitive_argument_type const& result)
+        {
+            std::int64_t bytes = detail::allocated_bytes(result);
+            allocated_bytes_ += bytes;
+            largest_result_bytes_ = (std::max)(largest_result_bytes_, bytes);
+        };
+
+        if (f.is_ready())
+        {
+            if (f.has_exception())
+            {
+                return std::move(f);
+            }
+
+            primitive_argument_type result = f.get();
+            record(result);
+            return hpx::make_ready_future(std::move(result));
+        }
+
+        return f.then(hpx::launch::sync,
+            [record](hpx::future<primitive_argument_type>&& f)
+            ->  primitive_argument_type
+            {
+                primitive_argument_type result = f.get();
+                record(result);
+                return result;
+            });
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        bool trace_shape(ir::node_data<T> const* nd,
+            util::eval_trace_event::shape_type& shape)
+        {
+            if (nd == nullptr)
+            {
+                return false;
+            }
+
+            auto dims = nd->dimensions();
+            shape[0] = static_cast<std::int64_t>(nd->num_dimensions());
+            if (shape[0] == 1)
+            {
+                shape[1] = static_cast<std::int64_t>(dims[1]);
+            }
+            else if (shape[0] == 2)
+            {
+                shape[1] = static_cast<std::int64_t>(dims[0]);
+                shape[2] = static_cast<std::int64_t>(dims[1]);
+            }
+            return true;
+        }
+
+        util::eval_trace_event::shape_type trace_shape(
+            primitive_argument_type const& val)
+        {
+            util::eval_trace_event::shape_type shape{{-1, 0, 0}};
+            trace_shape(util::get_if<ir::node_data<double>>(&val), shape) ||
+                trace_shape(
+                    util::get_if<ir::node_data<std::int64_t>>(&val), shape) ||
+                trace_shape(
+                    util::get_if<ir::node_data<std::uint8_t>>(&val), shape);
+            return shape;
+        }
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        std::int64_t element_count(ir::node_data<T> const* nd)
+        {
+            return nd == nullptr ? 0 : static_cast<std::int64_t>(nd->size());
+        }
+
+        // number of elements of the given value, zero for non-numeric values
+        std::int64_t element_count(primitive_argument_type const& val)
+        {
+            return element_count(util::get_if<ir::node_data<double>>(&val)) +
+                element_count(
+                    util::get_if<ir::node_data<std::int64_t>>(&val)) +
+                element_count(
+                    util::get_if<ir::node_data<std::uint8_t>>(&val));
+        }
+
+        std::int64_t element_count(
+            primitive_argument_type const* args, std::size_t num_args)
+        {
+            std::int64_t elements = 0;
+            for (std::size_t i = 0; i != num_args; ++i)
+            {
+                elements = (std::max)(elements, element_count(args[i]));
+            }
+            return elements;
+        }
+    }
+
+    constexpr std::size_t primitive_component_base::num_size_classes;
+
+    std::size_t primitive_component_base::size_class(std::int64_t elements)
+    {
+        std::size_t result = 0;
+        while (elements > 1 && result != num_size_classes - 1)
+        {
+            elements >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    hpx::future<primitive_argument_type>
+    primitive_component_base::record_size_class(
+        hpx::future<primitive_argument_type>&& f, std::int64_t elements,
+        std::int64_t start) const
+    {
+        auto record = [this, elements, start](
+            primitive_argument_type const& result)
+        {
+            std::size_t k = size_class(
+                (std::max)(elements, detail::element_count(result)));
+
+            ++size_histogram_->eval_count_[k];
+            size_histogram_->eval_duration_[k] +=
+                hpx::util::high_resolution_clock::now() - start;
+        };
+
+        if (f.is_ready())
+        {
+            if (f.has_exception())
+            {
+                return std::move(f);
+            }
+
+            primitive_argument_type result = f.get();
+            record(result);
+            return hpx::make_ready_future(std::move(result));
+        }
+
+        return f.then(hpx::launch::sync,
+            [record](hpx::future<primitive_argument_type>&& f)
+            ->  primitive_argument_type
+            {
+                primitive_argument_type result = f.get();
+                record(result);
+                return result;
+            });
+    }
+
+    util::eval_trace_event primitive_component_base::begin_eval_trace(
+        primitive_argument_type const* args, std::size_t num_args) const
+    {
+        if (trace_name_ == nullptr)
+        {
+            trace_name_ = util::eval_trace_intern(name_);
+        }
+
+        util::eval_trace_event event;
+        event.name_ = trace_name_;
+        event.worker_thread_ = hpx::get_worker_thread_num();
+        event.locality_ = hpx::get_locality_id();
+        event.num_args_ = static_cast<std::uint32_t>(num_args);
+        for (std::size_t i = 0;
+             i != num_args && i != util::eval_trace_event::max_args; ++i)
+        {
+            event.arg_shapes_[i] = detail::trace_shape(args[i]);
+        }
+        event.result_shape_ = util::eval_trace_event::shape_type{{-1, 0, 0}};
+        event.begin_ = hpx::util::high_resolution_clock::now();
+        event.end_ = event.begin_;
+        return event;
+    }
+
+    hpx::future<primitive_argument_type>
+    primitive_component_base::end_eval_trace(
+        hpx::future<primitive_argument_type>&& f,
+        util::eval_trace_event const& event) const
+    {
+        auto record = [event](primitive_argument_type const* result) mutable
+        {
+            event.end_ = hpx::util::high_resolution_clock::now();
+            if (result != nullptr)
+            {
+                event.result_shape_ = detail::trace_shape(*result);
+            }
+            util::record_eval_trace(event);
+        };
+
+        if (f.is_ready())
+        {
+            if (f.has_exception())
+            {
+                record(nullptr);
+                return std::move(f);
+            }
+
+            primitive_argument_type result = f.get();
+            record(&result);
+            return hpx::make_ready_future(std::move(result));
+        }
+
+        return f.then(hpx::launch::sync,
+            [record](hpx::future<primitive_argument_type>&& f) mutable
+            ->  primitive_argument_type
+            {
+                if (f.has_exception())
+                {
+                    record(nullptr);
+                    return f.get();     // rethrows the exception
+                }
+
+                primitive_argument_type result = f.get();
+                record(&result);
+                return result;
+            });
+    }
+
     hpx::future<primitive_argument_type> primitive_component_base::do_eval(
         primitive_arguments_type const& params,
         eval_mode mode) const
@@ -86,7 +341,41 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ++eval_count_;
         }
 
-        auto f = this->eval(params, mode);
+        bool const trace = util::eval_trace_enabled();
+        util::eval_trace_event event;
+        if (trace)
+        {
+            event = begin_eval_trace(params.data(), params.size());
+        }
+
+        std::int64_t elements = 0;
+        std::int64_t start = 0;
+        if (size_histogram_)
+        {
+            elements = detail::element_count(params.data(), params.size());
+            start = hpx::util::high_resolution_clock::now();
+        }
+
+        hpx::future<primitive_argument_type> f;
+        if (measurements_enabled_)
+        {
+            ir::scoped_copy_count copies(&copy_count_);
+            f = account_memory(this->eval(params, mode));
+        }
+        else
+        {
+            f = this->eval(params, mode);
+        }
+
+        if (size_histogram_)
+        {
+            f = record_size_class(std::move(f), elements, start);
+        }
+
+        if (trace)
+        {
+            f = end_eval_trace(std::move(f), event);
+        }
 
         if (enable_timer && !f.is_ready())
         {
@@ -118,7 +407,41 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ++eval_count_;
         }
 
-        auto f = this->eval(std::move(param), mode);
+        bool const trace = util::eval_trace_enabled();
+        util::eval_trace_event event;
+        if (trace)
+        {
+            event = begin_eval_trace(&param, 1);
+        }
+
+        std::int64_t elements = 0;
+        std::int64_t start = 0;
+        if (size_histogram_)
+        {
+            elements = detail::element_count(param);
+            start = hpx::util::high_resolution_clock::now();
+        }
+
+        hpx::future<primitive_argument_type> f;
+        if (measurements_enabled_)
+        {
+            ir::scoped_copy_count copies(&copy_count_);
+            f = account_memory(this->eval(std::move(param), mode));
+        }
+        else
+        {
+            f = this->eval(std::move(param), mode);
+        }
+
+        if (size_histogram_)
+        {
+            f = record_size_class(std::move(f), elements, start);
+        }
+
+        if (trace)
+        {
+            f = end_eval_trace(std::move(f), event);
+        }
 
         if (enable_timer && !f.is_ready())
         {
@@ -244,9 +567,52 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::util::get_and_reset_value(execute_directly_, reset);
     }
 
-    void primitive_component_base::enable_measurements()
+    std::int64_t primitive_component_base::get_allocated_bytes(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(allocated_bytes_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_largest_result_bytes(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(largest_result_bytes_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_copy_count(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(copy_count_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_size_class_eval_count(
+        std::size_t size_class, bool reset) const
+    {
+        if (!size_histogram_ || size_class >= num_size_classes)
+        {
+            return 0;
+        }
+        return hpx::util::get_and_reset_value(
+            size_histogram_->eval_count_[size_class], reset);
+    }
+
+    std::int64_t primitive_component_base::get_size_class_eval_duration(
+        std::size_t size_class, bool reset) const
+    {
+        if (!size_histogram_ || size_class >= num_size_classes)
+        {
+            return 0;
+        }
+        return hpx::util::get_and_reset_value(
+            size_histogram_->eval_duration_[size_class], reset);
+    }
+
+    void primitive_component_base::enable_measurements(bool size_histogram)
     {
         measurements_enabled_ = true;
+
+        if (size_histogram && !size_histogram_)
+        {
+            size_histogram_.reset(new size_class_data());
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #include <hpx/include/serialization.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/threads/run_as_os_thread.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/util/register_locks.hpp>
 
 #include <atomic>
@@ -34,9 +35,46 @@ namespace phylanx { namespace ir
     static std::atomic<std::int64_t> count_move_assignments_;
     static std::atomic<bool> enable_counts_;
 
+    // The counter receiving the copies on behalf of a primitive is stored in
+    // the data slot of the current HPX thread. It stays attached to the HPX
+    // thread even if that is resumed on a different worker thread.
+    static std::int64_t* current_copy_count()
+    {
+        hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+        if (id == hpx::threads::invalid_thread_id)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<std::int64_t*>(
+            hpx::threads::get_thread_data(id));
+    }
+
+    scoped_copy_count::scoped_copy_count(std::int64_t* count)
+      : id_(hpx::threads::get_self_id())
+      , prev_(nullptr)
+    {
+        if (id_ != hpx::threads::invalid_thread_id)
+        {
+            prev_ = reinterpret_cast<std::int64_t*>(
+                hpx::threads::set_thread_data(
+                    id_, reinterpret_cast<std::size_t>(count)));
+        }
+    }
+
+    scoped_copy_count::~scoped_copy_count()
+    {
+        if (id_ != hpx::threads::invalid_thread_id)
+        {
+            hpx::threads::set_thread_data(
+                id_, reinterpret_cast<std::size_t>(prev_));
+        }
+    }
+
     template <typename T>
     void node_data<T>::increment_copy_construction_count()
     {
+        if (std::int64_t* count = current_copy_count())
+            ++*count;
         if (enable_counts_.load(std::memory_order_relaxed))
             ++count_copy_constructions_;
     }
@@ -51,6 +89,8 @@ namespace phylanx { namespace ir
     template <typename T>
     void node_data<T>::increment_copy_assignment_count()
     {
+        if (std::int64_t* count = current_copy_count())
+            ++*count;
         if (enable_counts_.load(std::memory_order_relaxed))
             ++count_copy_assignments_;
     }
@@ -8,14 +8,18 @@
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
 #include <phylanx/ir/node_data.hpp>
 
 #include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
+#include <hpx/include/naming.hpp>
 #include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -64,23 +68,112 @@ namespace phylanx { namespace performance_counters
       : public hpx::performance_counters::base_performance_counter<
             primitive_counter>
     {
+    private:
+        using base_primitive_ptr = std::shared_ptr<
+            phylanx::execution_tree::primitives::primitive_component>;
+
+        // the value exposed by a particular counter instance
+        enum counter_kind
+        {
+            eval_count,
+            eval_duration,
+            allocated_bytes,
+            largest_result_bytes,
+            copy_count
+        };
+
+        static counter_kind extract_counter_kind(
+            hpx::performance_counters::counter_info const& info)
+        {
+            hpx::performance_counters::counter_path_elements paths;
+            hpx::performance_counters::get_counter_path_elements(
+                info.fullname_, paths);
+
+            std::string const& name = paths.countername_;
+            if (name.find("/time/eval") != std::string::npos)
+            {
+                return eval_duration;
+            }
+            if (name.find("/memory/allocated") != std::string::npos)
+            {
+                return allocated_bytes;
+            }
+            if (name.find("/memory/largest_result") != std::string::npos)
+            {
+                return largest_result_bytes;
+            }
+            if (name.find("/count/copies") != std::string::npos)
+            {
+                return copy_count;
+            }
+            return eval_count;
+        }
+
+        // counter instances 'size_class#<k>' expose the eval count and
+        // duration of the evaluations falling into size class k only
+        static std::int64_t extract_size_class(
+            hpx::performance_counters::counter_info const& info)
+        {
+            hpx::performance_counters::counter_path_elements paths;
+            hpx::performance_counters::get_counter_path_elements(
+                info.fullname_, paths);
+
+            if (paths.instancename_ == "size_class")
+            {
+                return paths.instanceindex_;
+            }
+            return -1;
+        }
+
+        std::int64_t get_value(
+            base_primitive_ptr const& instance, bool reset) const
+        {
+            if (size_class_ >= 0)
+            {
+                if (kind_ == eval_duration)
+                {
+                    return instance->get_size_class_eval_duration(
+                        static_cast<std::size_t>(size_class_), reset);
+                }
+                return instance->get_size_class_eval_count(
+                    static_cast<std::size_t>(size_class_), reset);
+            }
+
+            switch (kind_)
+            {
+            case eval_duration:
+                return instance->get_eval_duration(reset);
+
+            case allocated_bytes:
+                return instance->get_allocated_bytes(reset);
+
+            case largest_result_bytes:
+                return instance->get_largest_result_bytes(reset);
+
+            case copy_count:
+                return instance->get_copy_count(reset);
+
+            case eval_count: HPX_FALLTHROUGH;
+            default:
+                break;
+            }
+            return instance->get_eval_count(reset);
+        }
+
     public:
         primitive_counter()
           : first_init_(false)
-          , duration_counter_(false)
+          , kind_(eval_count)
+          , size_class_(-1)
         {}
 
         primitive_counter(hpx::performance_counters::counter_info const& info)
           : hpx::performance_counters::base_performance_counter<
                 primitive_counter>(info)
           , first_init_(false)
-          , duration_counter_(false)
+          , kind_(extract_counter_kind(info))
+          , size_class_(extract_size_class(info))
         {
-            hpx::performance_counters::counter_path_elements paths;
-            hpx::performance_counters::get_counter_path_elements(
-                info.fullname_, paths);
-            duration_counter_ =
-                paths.countername_.find("time") != std::string::npos;
         }
 
         // Produce the counter value
@@ -106,14 +199,7 @@ namespace phylanx { namespace performance_counters
             // Extract the values from instances_
             for (auto const& instance : instances_)
             {
-                if (duration_counter_)
-                {
-                    result.push_back(instance->get_eval_duration(reset));
-                }
-                else
-                {
-                    result.push_back(instance->get_eval_count(reset));
-                }
+                result.push_back(get_value(instance, reset));
             }
 
             value.values_ = std::move(result);
@@ -130,12 +216,17 @@ namespace phylanx { namespace performance_counters
             auto entries = hpx::agas::find_symbols(hpx::launch::sync,
                 "/phylanx/" + detail::extract_primitive_type(info_) + "$*");
 
-            // TODO: Only keep entries that live on this locality.
-            // This will be a problem when Phylanx becomes distributed.
+            // Only keep entries that live on this locality
+            std::uint32_t const here = hpx::get_locality_id();
             std::map<std::int64_t, base_primitive_ptr> instances_sorted;
 
             for (auto const& value : entries)
             {
+                if (hpx::naming::get_locality_id_from_id(value.second) != here)
+                {
+                    continue;
+                }
+
                 auto const& instance = hpx::get_ptr<
                     phylanx::execution_tree::primitives::primitive_component>(
                         hpx::launch::sync, value.second);
@@ -144,25 +235,18 @@ namespace phylanx { namespace performance_counters
                     phylanx::execution_tree::compiler::parse_primitive_name(
                         value.first);
 
-                instance->enable_measurements();
+                instance->enable_measurements(size_class_ >= 0);
 
                 // Consider the reset flag
                 if (reset)
                 {
-                    if (duration_counter_)
-                    {
-                        instance->get_eval_duration(true);
-                    }
-                    else
-                    {
-                        instance->get_eval_count(true);
-                    }
+                    get_value(instance, true);
                 }
                 instances_sorted[instance_info.sequence_number] = instance;
             }
 
             instances_.clear();
-            instances_.reserve(entries.size());
+            instances_.reserve(instances_sorted.size());
 
             for (auto && value : instances_sorted)
             {
@@ -173,12 +257,10 @@ namespace phylanx { namespace performance_counters
         }
 
     private:
-        using base_primitive_ptr = std::shared_ptr<
-            phylanx::execution_tree::primitives::primitive_component>;
-
         std::vector<base_primitive_ptr> instances_;
         std::atomic<bool> first_init_;
-        bool duration_counter_;
+        counter_kind kind_;
+        std::int64_t size_class_;
     };
 
     hpx::naming::gid_type primitive_counter_creator(
@@ -203,7 +285,17 @@ namespace phylanx { namespace performance_counters
             return hpx::naming::invalid_gid;
         }
 
-        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        // the eval count and duration counters can be bucketed by size class
+        bool is_size_class = paths.instancename_ == "size_class" &&
+            paths.instanceindex_ >= 0 &&
+            paths.instanceindex_ < std::int64_t(
+                execution_tree::primitives::primitive_component_base::
+                    num_size_classes) &&
+            (paths.countername_.find("/time/eval") != std::string::npos ||
+                paths.countername_.find("/count/eval") != std::string::npos);
+
+        if ((paths.instancename_ == "total" && paths.instanceindex_ == -1) ||
+            is_size_class)
         {
             pc::counter_info complemented_info = info;
             pc::complement_counter_info(complemented_info, info, ec);
@@ -296,12 +388,17 @@ namespace phylanx { namespace performance_counters
             auto entries = hpx::agas::find_symbols(hpx::launch::sync,
                 "/phylanx/" + detail::extract_primitive_type(info_) + "$*");
 
-            // TODO: Only keep entries that live on this locality.
-            // This will be a problem when Phylanx becomes distributed.
+            // Only keep entries that live on this locality
+            std::uint32_t const here = hpx::get_locality_id();
             std::map<std::int64_t, base_primitive_ptr> instances_sorted;
 
             for (auto const& value : entries)
             {
+                if (hpx::naming::get_locality_id_from_id(value.second) != here)
+                {
+                    continue;
+                }
+
                 auto const& instance = hpx::get_ptr<
                     phylanx::execution_tree::primitives::primitive_component>(
                         hpx::launch::sync, value.second);
@@ -319,7 +416,7 @@ namespace phylanx { namespace performance_counters
             }
 
             instances_.clear();
-            instances_.reserve(entries.size());
+            instances_.reserve(instances_sorted.size());
             for (auto const& value : instances_sorted)
             {
                 instances_.push_back(value.second);
@@ -441,7 +538,9 @@ namespace phylanx { namespace performance_counters
                 hpx::performance_counters::counter_raw_values,
                 "returns a list whose elements contain the total execution "
                     "time of the eval function for each " +
-                    name + " primitive",
+                    name + " primitive (use the instance 'size_class#<k>' "
+                    "to restrict this to evaluations involving [2^k, "
+                    "2^(k+1)) elements)",
                 &primitive_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer,
                 HPX_PERFORMANCE_COUNTER_V1, "ns");
@@ -452,7 +551,39 @@ namespace phylanx { namespace performance_counters
                 hpx::performance_counters::counter_raw_values,
                 "returns a list whose elements contain the number of times "
                     "the eval function was called for each " +
-                    name + " primitive",
+                    name + " primitive (use the instance 'size_class#<k>' "
+                    "to restrict this to evaluations involving [2^k, "
+                    "2^(k+1)) elements)",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            // Register the memory accounting performance counters
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/allocated",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the total number of "
+                    "bytes allocated for the results of the eval function "
+                    "for each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/largest_result",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the largest number of "
+                    "bytes held by a single result of the eval function for "
+                    "each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/copies",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of "
+                    "node_data copies performed by the HPX thread executing "
+                    "the eval function for each " + name + " primitive",
                 &primitive_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
 
@@ -8,14 +8,17 @@
 
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,8 +36,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         "ratings, reg, num, iters, alpha, enable_output\n"
         "Args:\n"
         "\n"
-        "    ratings (matrix): the matrix representing user feedback over\n"
-        "                     different items\n"
+        "    ratings (matrix or list): the matrix representing user feedback\n"
+        "                     over different items, or the non-zero\n"
+        "                     feedback in coordinate form given as\n"
+        "                     list(users, items, values) or as\n"
+        "                     list(users, items, values, num_users,\n"
+        "                     num_items)\n"
         "    reg (float): the regularization parameter\n"
         "    num (integer): the number of factors\n"
         "    iters (integer): the number of iterations\n"
@@ -58,19 +65,192 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type als::calculate_als(
-        primitive_arguments_type && args) const
+    namespace detail
     {
-        // extract arguments
-        auto arg1 = extract_numeric_value(args[0], name_, codename_);
-        if (arg1.num_dimensions() != 2)
+        using vector_type = ir::node_data<double>::storage1d_type;
+        using matrix_type = ir::node_data<double>::storage2d_type;
+
+        // ratings are stored by user (rows) and by item (columns), zero
+        // entries are not stored
+        using ratings_by_user_type =
+            blaze::CompressedMatrix<double, blaze::rowMajor>;
+        using ratings_by_item_type =
+            blaze::CompressedMatrix<double, blaze::columnMajor>;
+
+        // Solve the least squares problems for all rows of X (Hu et al.):
+        //
+        //      (YtY + Y^T (C_u - I) Y) x_u = Y^T C_u p_u
+        //
+        // where YtY = Y^T Y + reg * I is shared by all rows and C_u - I is
+        // non-zero only for the items rated by u. Each row costs
+        // O(nnz_u * f^2 + f^3) instead of O(num_items * f^2) and the rows
+        // are solved concurrently.
+        template <typename Ratings>
+        void update_factors(matrix_type& X, matrix_type const& Y,
+            matrix_type const& YtY, Ratings const& ratings, double alpha)
+        {
+            std::size_t num_factors = blaze::columns(Y);
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), blaze::rows(X),
+                [&](std::size_t u)
+                {
+                    auto row_x = blaze::row(X, u);
+                    if (ratings.begin(u) == ratings.end(u))
+                    {
+                        row_x = 0.0;
+                        return;
+                    }
+
+                    matrix_type A(YtY);
+                    vector_type b(num_factors, 0.0);
+
+                    for (auto it = ratings.begin(u); it != ratings.end(u);
+                         ++it)
+                    {
+                        double conf = alpha * it->value();
+                        auto y = blaze::row(Y, it->index());
+
+                        A += conf * (blaze::trans(y) * y);
+                        b += (1.0 + conf) * blaze::trans(y);
+                    }
+
+                    // A is symmetric positive definite
+                    blaze::posv(A, b, 'U');
+                    row_x = blaze::trans(b);
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::CompressedMatrix<double> als::extract_ratings(
+        primitive_argument_type const& arg) const
+    {
+        if (!is_list_operand_strict(arg))
+        {
+            auto ratings = extract_numeric_value(arg, name_, codename_);
+            if (ratings.num_dimensions() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                    generate_error_message(
+                        "the als algorithm primitive requires for the first "
+                        "argument ('ratings') to represent a matrix or a "
+                        "list of coordinates"));
+            }
+            return blaze::CompressedMatrix<double>(ratings.matrix());
+        }
+
+        // ratings in coordinate form: users, items, values[, rows, columns]
+        std::vector<primitive_argument_type> parts;
+        auto&& list = extract_list_value_strict(arg, name_, codename_);
+        for (auto const& part : list)
+        {
+            parts.push_back(part);
+        }
+
+        if (parts.size() != 3 && parts.size() != 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
                 generate_error_message(
-                    "the als algorithm primitive requires for the first "
-                    "argument ('ratings') to represent a matrix"));
+                    "the als algorithm primitive requires for the sparse "
+                    "ratings to be given as list(users, items, values) or "
+                    "list(users, items, values, num_users, num_items)"));
+        }
+
+        auto users = extract_integer_value(parts[0], name_, codename_);
+        auto items = extract_integer_value(parts[1], name_, codename_);
+        auto values = extract_numeric_value(parts[2], name_, codename_);
+        if (users.num_dimensions() != 1 || items.num_dimensions() != 1 ||
+            values.num_dimensions() != 1 || users.size() != items.size() ||
+            users.size() != values.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                generate_error_message(
+                    "the als algorithm primitive requires for the users, "
+                    "items, and values of the sparse ratings to be vectors "
+                    "of the same size"));
+        }
+
+        auto u = users.vector();
+        auto i = items.vector();
+        auto v = values.vector();
+        std::size_t nnz = u.size();
+
+        std::int64_t num_users = 0;
+        std::int64_t num_items = 0;
+        if (parts.size() == 5)
+        {
+            num_users =
+                extract_scalar_integer_value(parts[3], name_, codename_);
+            num_items =
+                extract_scalar_integer_value(parts[4], name_, codename_);
+        }
+        else
+        {
+            for (std::size_t k = 0; k != nnz; ++k)
+            {
+                num_users = (std::max)(num_users, u[k] + 1);
+                num_items = (std::max)(num_items, i[k] + 1);
+            }
+        }
+
+        for (std::size_t k = 0; k != nnz; ++k)
+        {
+            if (u[k] < 0 || u[k] >= num_users || i[k] < 0 ||
+                i[k] >= num_items)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                    generate_error_message(
+                        "the als algorithm primitive requires for the "
+                        "indices of the sparse ratings to be in range"));
+            }
         }
-        auto ratings = arg1.matrix();
+
+        // the compressed matrix has to be filled row by row with increasing
+        // column indices
+        std::vector<std::size_t> order(nnz);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::sort(order.begin(), order.end(),
+            [&](std::size_t lhs, std::size_t rhs)
+            {
+                return u[lhs] < u[rhs] || (u[lhs] == u[rhs] && i[lhs] < i[rhs]);
+            });
+
+        blaze::CompressedMatrix<double> ratings(num_users, num_items);
+        ratings.reserve(nnz);
+
+        std::size_t k = 0;
+        for (std::int64_t row = 0; row != num_users; ++row)
+        {
+            for (/**/; k != nnz && u[order[k]] == row; ++k)
+            {
+                std::size_t idx = order[k];
+                if (k != 0 && u[order[k - 1]] == row &&
+                    i[order[k - 1]] == i[idx])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, "als::eval",
+                        generate_error_message(
+                            "the als algorithm primitive requires for each "
+                            "pair of user and item to be rated at most "
+                            "once"));
+                }
+                if (v[idx] != 0.0)
+                {
+                    ratings.append(row, i[idx], v[idx]);
+                }
+            }
+            ratings.finalize(row);
+        }
+        return ratings;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type als::calculate_als(
+        primitive_arguments_type && args) const
+    {
+        // extract arguments
+        detail::ratings_by_user_type ratings_by_user = extract_ratings(args[0]);
+        detail::ratings_by_item_type ratings_by_item(ratings_by_user);
 
         auto arg2 = extract_numeric_value(args[1], name_, codename_);
         if (arg2.num_dimensions() != 0)
@@ -103,13 +283,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 extract_scalar_integer_value(args[5], name_, codename_) != 0;
         }
 
-        using vector_type = ir::node_data<double>::storage1d_type;
-        using matrix_type = ir::node_data<double>::storage2d_type;
+        using matrix_type = detail::matrix_type;
 
         // perform calculations
-        std::int64_t num_users = ratings.rows();
-        std::int64_t num_items = ratings.columns();
-        auto conf = alpha * ratings;
+        std::int64_t num_users = ratings_by_user.rows();
+        std::int64_t num_items = ratings_by_user.columns();
 
         matrix_type X(num_users, num_factors);
         matrix_type Y(num_items, num_factors);
@@ -138,11 +316,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
 
         blaze::IdentityMatrix<double> I_f(num_factors);
-        blaze::IdentityMatrix<double> I_i(num_items);
-        blaze::IdentityMatrix<double> I_u(num_users);
-
-        blaze::DynamicMatrix<double> c_u(num_items, num_items, 0);
-        blaze::DynamicMatrix<double> c_i(num_users, num_users, 0);
 
         for (std::int64_t step = 0; step < iterations; ++step)
         {
@@ -155,31 +328,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                           << "\nY: " << Y << std::endl;
             }
 
-            for (std::int64_t u = 0; u < num_users; u++)
-            {
-                auto conf_u = blaze::trans(blaze::row(conf, u));
-                auto diag = blaze::band(c_u, 0);
-                diag = conf_u;
-                auto p_u =
-                    blaze::map(conf_u, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(Y) * c_u) * Y + YtY;
-                auto b = (blaze::trans(Y) * (c_u + I_i)) * (p_u);
-                auto row_x = blaze::row(X, u);
-                row_x = (trans(b) * blaze::inv(A));
-            }
-
-            for (std::int64_t i = 0; i < num_items; i++)
-            {
-                auto conf_i = blaze::column(conf, i);
-                auto diag = blaze::band(c_i, 0);
-                diag = conf_i;
-                auto p_i =
-                    blaze::map(conf_i, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(X) * c_i) * X + XtX;
-                auto b = (blaze::trans(X) * (c_i + I_u)) * (p_i);
-                auto row_y = blaze::row(Y, i);
-                row_y = (trans(b) * blaze::inv(A));
-            }
+            detail::update_factors(X, Y, YtY, ratings_by_user, alpha);
+            detail::update_factors(Y, X, XtX, ratings_by_item, alpha);
         }
 
         return primitive_argument_type
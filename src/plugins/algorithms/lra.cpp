@@ -5,18 +5,21 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/lra.hpp>
-#include <phylanx/util/detail/add_simd.hpp>
-#include <phylanx/util/detail/div_simd.hpp>
 
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,20 +34,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         hpx::util::make_tuple("lra",
             std::vector<std::string>{
+                "lra(_1, _2, _3, _4, _5, _6, _7, _8)",
+                "lra(_1, _2, _3, _4, _5, _6, _7)",
+                "lra(_1, _2, _3, _4, _5, _6)",
                 "lra(_1, _2, _3, _4, _5)",
                 "lra(_1, _2, _3, _4)"
             },
             &create_lra, &create_primitive<lra>,
-            "x, y, alpha, iters, enable_output\n"
+            "x, y, alpha, iters, enable_output, batch_size, shuffle, "
+            "tolerance\n"
             "Args:\n"
             "\n"
             "    x (matrix) : a matrix\n"
             "    y (vector) : a vector\n"
             "the data\n"
             "    alpha (float): It is the learning rate\n"
-            "    iters (int): The number of iterations\n"
+            "    iters (int): The number of iterations (passes over the data)\n"
             "    enable_output (optional, boolean): If enabled, prints out the step "
             "number and weights during each iteration\n"
+            "    batch_size (optional, int): The number of rows used for each "
+            "update of the weights, all rows are used if zero (default: 0)\n"
+            "    shuffle (optional, boolean): If enabled, the rows are visited "
+            "in a different random order during each iteration "
+            "(default: false)\n"
+            "    tolerance (optional, float): Stop early once the weights "
+            "change by less than this (maximum norm) during an iteration "
+            "(default: 0, never stop early)\n"
             "\n"
             "Returns:\n"
             "\n"
@@ -58,6 +73,69 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using vector_type = ir::node_data<double>::storage1d_type;
+
+        // minimal number of rows handled by one task
+        constexpr std::size_t lra_min_chunk_size = 1024;
+
+        // gradient = transpose(x[rows]) . (sigmoid(dot(x[rows], weights)) -
+        // y[rows]), where rows = order[begin:end]
+        //
+        // The rows are split into chunks, each calculating a partial gradient
+        // concurrently. The partial gradients are reduced in a fixed order to
+        // keep the result deterministic.
+        template <typename Matrix, typename Vector>
+        void lra_gradient(Matrix const& x, Vector const& y,
+            vector_type const& weights, std::vector<std::size_t> const& order,
+            std::size_t begin, std::size_t end,
+            std::vector<vector_type>& partials, vector_type& gradient)
+        {
+            std::size_t rows = end - begin;
+            std::size_t num_chunks = (std::min)(
+                (rows + lra_min_chunk_size - 1) / lra_min_chunk_size,
+                std::size_t(4 * hpx::get_os_thread_count()));
+            if (num_chunks == 0)
+            {
+                num_chunks = 1;
+            }
+            std::size_t chunk_size = (rows + num_chunks - 1) / num_chunks;
+
+            if (partials.size() < num_chunks)
+            {
+                partials.resize(num_chunks);
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_chunks,
+                [&](std::size_t chunk)
+                {
+                    vector_type& partial = partials[chunk];
+                    partial.resize(weights.size(), false);
+                    partial = 0.0;
+
+                    std::size_t first = begin + chunk * chunk_size;
+                    std::size_t last = (std::min)(first + chunk_size, end);
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        auto row = blaze::trans(blaze::row(x, order[i]));
+
+                        double pred =
+                            1.0 / (1.0 + std::exp(-blaze::dot(row, weights)));
+                        partial += (pred - y[order[i]]) * row;
+                    }
+                });
+
+            gradient = partials[0];
+            for (std::size_t chunk = 1; chunk != num_chunks; ++chunk)
+            {
+                gradient += partials[chunk];
+            }
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type lra::calculate_lra(
         primitive_arguments_type && args) const
@@ -106,18 +184,68 @@ namespace phylanx { namespace execution_tree { namespace primitives
             extract_scalar_integer_value(args[3], name_, codename_);
 
         bool enable_output = false;
-        if (args.size() == 5 && valid(args[4]))
+        if (args.size() > 4 && valid(args[4]))
         {
             enable_output =
                 extract_scalar_boolean_value(args[4], name_, codename_) != 0;
         }
 
-        using vector_type = ir::node_data<double>::storage1d_type;
-        using matrix_type = ir::node_data<double>::storage2d_type;
+        std::size_t num_rows = x.rows();
+
+        std::size_t batch_size = num_rows;
+        if (args.size() > 5 && valid(args[5]))
+        {
+            auto size =
+                extract_scalar_integer_value(args[5], name_, codename_);
+            if (size < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra::eval",
+                    generate_error_message(
+                        "the lra algorithm primitive requires for the "
+                        "sixth argument ('batch_size') to be non-negative"));
+            }
+            if (size != 0 && std::size_t(size) < num_rows)
+            {
+                batch_size = std::size_t(size);
+            }
+        }
+
+        bool shuffle = false;
+        if (args.size() > 6 && valid(args[6]))
+        {
+            shuffle =
+                extract_scalar_boolean_value(args[6], name_, codename_) != 0;
+        }
+
+        double tolerance = 0.0;
+        if (args.size() > 7 && valid(args[7]))
+        {
+            auto arg8 = extract_numeric_value(args[7], name_, codename_);
+            if (arg8.num_dimensions() != 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra::eval",
+                    generate_error_message(
+                        "the lra algorithm primitive requires for the "
+                        "eighth argument ('tolerance') to represent a "
+                        "scalar"));
+            }
+            tolerance = arg8.scalar();
+        }
+
+        using vector_type = detail::vector_type;
 
         // perform calculations
         vector_type weights(x.columns(), 0.0);
-        matrix_type transx = blaze::trans(x);
+        vector_type previous(x.columns());
+        vector_type gradient(x.columns());
+        std::vector<vector_type> partials;
+
+        // order in which the rows are visited
+        std::vector<std::size_t> order(num_rows);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+
+        std::uint32_t seed_ = 0;
+        std::mt19937 rng_{seed_};
 
         for (std::int64_t step = 0; step < iterations; ++step)
         {
@@ -126,13 +254,39 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 hpx::cout << "step: " << step << ", " << weights << std::endl;
             }
 
-            // pred = 1.0 / (1.0 + exp(-dot(x, weights)))
-            auto pred = blaze::map(
-                blaze::map(blaze::exp(-(x * weights)),
-                    util::detail::addnd0d_simd(1.0)),
-                util::detail::div0dnd_simd(1.0));
+            if (shuffle)
+            {
+                std::shuffle(order.begin(), order.end(), rng_);
+            }
+
+            if (tolerance > 0.0)
+            {
+                previous = weights;
+            }
+
+            for (std::size_t begin = 0; begin < num_rows; begin += batch_size)
+            {
+                std::size_t end = (std::min)(begin + batch_size, num_rows);
+
+                detail::lra_gradient(
+                    x, y, weights, order, begin, end, partials, gradient);
+
+                weights -= alpha * gradient;
+            }
 
-            weights = weights - (alpha * (transx * (pred - y)));
+            if (tolerance > 0.0)
+            {
+                double change = 0.0;
+                for (std::size_t i = 0; i != weights.size(); ++i)
+                {
+                    change = (std::max)(
+                        change, std::abs(weights[i] - previous[i]));
+                }
+                if (change < tolerance)
+                {
+                    break;
+                }
+            }
         }
 
         return primitive_argument_type{std::move(weights)};
@@ -143,13 +297,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args) const
     {
-        if (operands.size() != 4 && operands.size() != 5)
+        if (operands.size() < 4 || operands.size() > 8)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "lra::eval",
                 generate_error_message(
-                    "the lra algorithm primitive requires exactly either "
-                        "four or five operands"));
+                    "the lra algorithm primitive requires between four "
+                        "and eight operands"));
         }
 
         bool arguments_valid = true;
@@ -1040,13 +1040,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 -> primitive_argument_type
                 {
                     auto && lhs_val = lhs.get();
+                    auto && rhs_val = rhs.get();
+
+                    // partitioned arrays are lists as well, they have to be
+                    // handled first
+                    if (is_partitioned_operand(lhs_val) ||
+                        is_partitioned_operand(rhs_val))
+                    {
+                        return partitioned_operation("add_d",
+                            std::move(lhs_val), std::move(rhs_val),
+                            this_->codename_);
+                    }
                     if (is_list_operand_strict(lhs_val))
                     {
                         return this_->handle_list_operands(
-                            std::move(lhs_val), rhs.get());
+                            std::move(lhs_val), std::move(rhs_val));
                     }
                     return this_->handle_numeric_operands(
-                        std::move(lhs_val), rhs.get());
+                        std::move(lhs_val), std::move(rhs_val));
                 },
                 value_operand(operands[0], args, name_, codename_),
                 value_operand(operands[1], args, name_, codename_));
@@ -1056,6 +1067,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             [this_ = std::move(this_)](primitive_arguments_type&& ops)
             ->  primitive_argument_type
             {
+                if (any_partitioned_operand(ops))
+                {
+                    return partitioned_operation(
+                        "add_d", std::move(ops), this_->codename_);
+                }
                 if (is_list_operand_strict(ops[0]))
                 {
                     return this_->handle_list_operands(std::move(ops));
@@ -943,10 +943,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
         if (operands.size() == 2)
         {
             return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-                [this_ = std::move(this_)](
-                        operand_type&& lhs, operand_type&& rhs)
+                [this_ = std::move(this_)](primitive_argument_type&& lhs_val,
+                    primitive_argument_type&& rhs_val)
                 ->  primitive_argument_type
                 {
+                    if (is_partitioned_operand(lhs_val) ||
+                        is_partitioned_operand(rhs_val))
+                    {
+                        return partitioned_operation("mul_d",
+                            std::move(lhs_val), std::move(rhs_val),
+                            this_->codename_);
+                    }
+
+                    operand_type lhs = extract_numeric_value(
+                        std::move(lhs_val), this_->name_, this_->codename_);
+                    operand_type rhs = extract_numeric_value(
+                        std::move(rhs_val), this_->name_, this_->codename_);
+
                     std::size_t lhs_dims = lhs.num_dimensions();
                     switch (lhs_dims)
                     {
@@ -968,14 +981,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 this_->name_, this_->codename_));
                     }
                 }),
-                numeric_operand(operands[0], args, name_, codename_),
-                numeric_operand(operands[1], args, name_, codename_));
+                value_operand(operands[0], args, name_, codename_),
+                value_operand(operands[1], args, name_, codename_));
         }
 
         return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-            [this_ = std::move(this_)](operands_type&& ops)
+            [this_ = std::move(this_)](primitive_arguments_type&& vals)
             ->  primitive_argument_type
             {
+                if (any_partitioned_operand(vals))
+                {
+                    return partitioned_operation(
+                        "mul_d", std::move(vals), this_->codename_);
+                }
+
+                operands_type ops;
+                ops.reserve(vals.size());
+                for (auto&& val : vals)
+                {
+                    ops.emplace_back(extract_numeric_value(
+                        std::move(val), this_->name_, this_->codename_));
+                }
+
                 std::size_t lhs_dims = ops[0].num_dimensions();
                 switch (lhs_dims)
                 {
@@ -998,7 +1025,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }),
             detail::map_operands(
-                operands, functional::numeric_operand{}, args,
+                operands, functional::value_operand{}, args,
                 name_, codename_));
     }
 
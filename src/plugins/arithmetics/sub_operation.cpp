@@ -913,9 +913,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
         if (operands.size() == 2)
         {
             return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-                [this_ = std::move(this_)](arg_type&& lhs, arg_type&& rhs)
+                [this_ = std::move(this_)](primitive_argument_type&& lhs_val,
+                    primitive_argument_type&& rhs_val)
                 -> primitive_argument_type
                 {
+                    if (is_partitioned_operand(lhs_val) ||
+                        is_partitioned_operand(rhs_val))
+                    {
+                        return partitioned_operation("sub_d",
+                            std::move(lhs_val), std::move(rhs_val),
+                            this_->codename_);
+                    }
+
+                    arg_type lhs = extract_numeric_value(
+                        std::move(lhs_val), this_->name_, this_->codename_);
+                    arg_type rhs = extract_numeric_value(
+                        std::move(rhs_val), this_->name_, this_->codename_);
+
                     std::size_t lhs_dims = lhs.num_dimensions();
                     switch (lhs_dims)
                     {
@@ -937,14 +951,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 this_->name_, this_->codename_));
                     }
                 }),
-                numeric_operand(operands[0], args, name_, codename_),
-                numeric_operand(operands[1], args, name_, codename_));
+                value_operand(operands[0], args, name_, codename_),
+                value_operand(operands[1], args, name_, codename_));
         }
 
         return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-            [this_ = std::move(this_)](args_type&& args)
+            [this_ = std::move(this_)](primitive_arguments_type&& vals)
             -> primitive_argument_type
             {
+                if (any_partitioned_operand(vals))
+                {
+                    return partitioned_operation(
+                        "sub_d", std::move(vals), this_->codename_);
+                }
+
+                args_type args;
+                args.reserve(vals.size());
+                for (auto&& val : vals)
+                {
+                    args.emplace_back(extract_numeric_value(
+                        std::move(val), this_->name_, this_->codename_));
+                }
+
                 std::size_t lhs_dims = args[0].num_dimensions();
                 switch (lhs_dims)
                 {
@@ -967,7 +995,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }),
             detail::map_operands(
-                operands, functional::numeric_operand{}, args,
+                operands, functional::value_operand{}, args,
                 name_, codename_));
     }
 
@@ -6,6 +6,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/all_operation.hpp>
+#include <phylanx/util/bit_mask.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -56,16 +57,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type all_operation::all1d(T&& arg) const
     {
         auto value = arg.vector();
-        return primitive_argument_type{
-            ir::node_data<std::uint8_t>{value.nonZeros() == value.size()}};
+        return primitive_argument_type{ir::node_data<std::uint8_t>{
+            util::mask_all(value.size(),
+                [&](std::size_t i)
+                {
+                    return value[i] != 0;
+                })}};
     }
 
     template <typename T>
     primitive_argument_type all_operation::all2d(T&& arg) const
     {
         auto value = arg.matrix();
-        return primitive_argument_type{ir::node_data<std::uint8_t>{
-            value.nonZeros() == value.rows() * value.columns()}};
+        for (std::size_t row = 0; row != value.rows(); ++row)
+        {
+            bool result = util::mask_all(value.columns(),
+                [&](std::size_t column)
+                {
+                    return value(row, column) != 0;
+                });
+            if (!result)
+            {
+                return primitive_argument_type{
+                    ir::node_data<std::uint8_t>{false}};
+            }
+        }
+        return primitive_argument_type{ir::node_data<std::uint8_t>{true}};
     }
 
     template <typename T>
@@ -6,6 +6,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/any_operation.hpp>
+#include <phylanx/util/bit_mask.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -56,17 +57,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type any_operation::any1d(T&& arg) const
     {
         auto value = arg.vector();
-        return primitive_argument_type{
-            ir::node_data<std::uint8_t>{value.nonZeros() != 0}};
+        return primitive_argument_type{ir::node_data<std::uint8_t>{
+            util::mask_any(value.size(),
+                [&](std::size_t i)
+                {
+                    return value[i] != 0;
+                })}};
     }
 
     template <typename T>
-
     primitive_argument_type any_operation::any2d(T&& arg) const
     {
         auto value = arg.matrix();
-        return primitive_argument_type{
-            ir::node_data<std::uint8_t>{value.nonZeros() != 0}};
+        for (std::size_t row = 0; row != value.rows(); ++row)
+        {
+            bool result = util::mask_any(value.columns(),
+                [&](std::size_t column)
+                {
+                    return value(row, column) != 0;
+                });
+            if (result)
+            {
+                return primitive_argument_type{
+                    ir::node_data<std::uint8_t>{true}};
+            }
+        }
+        return primitive_argument_type{ir::node_data<std::uint8_t>{false}};
     }
 
     template <typename T>
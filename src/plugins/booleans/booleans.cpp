@@ -17,6 +17,18 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(any_operation_plugin,
     phylanx::execution_tree::primitives::any_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(equal_plugin,
     phylanx::execution_tree::primitives::equal::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_eq_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_ne_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_lt_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[2]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_le_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[3]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_gt_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[4]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(where_ge_plugin,
+    phylanx::execution_tree::primitives::fused_where::match_data[5]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(greater_plugin,
     phylanx::execution_tree::primitives::greater::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(greater_equal_plugin,
@@ -0,0 +1,487 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/booleans/fused_where.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime/find_here.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+#define PHYLANX_FUSED_WHERE_MATCH_DATA(op, name, symbol)                       \
+        hpx::util::make_tuple("__where_" name,                                 \
+            std::vector<std::string>{                                          \
+                "__where_" name "(_1, _2, _3, _4)",                            \
+                "where(_1 " symbol " _2, _3, _4)"},                            \
+            &create_where_##op, &create_primitive<fused_where>,                \
+            "lhs, rhs, a, b\n"                                                 \
+            "Args:\n"                                                          \
+            "\n"                                                               \
+            "    lhs (number) : A value to compare\n"                          \
+            "    rhs (number) : Another value to compare\n"                    \
+            "    a (number) : the values to use where the comparison holds\n"  \
+            "    b (number) : the values to use otherwise\n"                   \
+            "\n"                                                               \
+            "Returns:\n"                                                       \
+            "\n"                                                               \
+            "The same as where(lhs " symbol " rhs, a, b), computed in a "      \
+            "single pass without creating the intermediate boolean array."     \
+        )                                                                      \
+    /**/
+
+    std::vector<match_pattern_type> const fused_where::match_data =
+    {
+        PHYLANX_FUSED_WHERE_MATCH_DATA(eq, "eq", "=="),
+        PHYLANX_FUSED_WHERE_MATCH_DATA(ne, "ne", "!="),
+        PHYLANX_FUSED_WHERE_MATCH_DATA(lt, "lt", "<"),
+        PHYLANX_FUSED_WHERE_MATCH_DATA(le, "le", "<="),
+        PHYLANX_FUSED_WHERE_MATCH_DATA(gt, "gt", ">"),
+        PHYLANX_FUSED_WHERE_MATCH_DATA(ge, "ge", ">=")
+    };
+
+#undef PHYLANX_FUSED_WHERE_MATCH_DATA
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string extract_fused_where_name(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                std::string::size_type p = name.find_first_of("$");
+                if (p != std::string::npos)
+                {
+                    return name.substr(0, p);
+                }
+            }
+
+            return name_parts.primitive;
+        }
+
+        // Element (row, column) of an operand broadcast to the shape of the
+        // result. Scalars use zero for both steps, vectors are broadcast
+        // along the rows of a matrix by using a zero row step.
+        template <typename T>
+        struct fused_operand
+        {
+            T operator()(std::size_t row, std::size_t column) const
+            {
+                return data_[row * row_step_ + column * column_step_];
+            }
+
+            T const* data_;
+            std::size_t row_step_;
+            std::size_t column_step_;
+        };
+
+        template <typename T>
+        fused_operand<T> make_fused_operand(ir::node_data<T> const& arg,
+            std::size_t rows, std::size_t columns, std::string const& name,
+            std::string const& codename)
+        {
+            switch (arg.num_dimensions())
+            {
+            case 0:
+                return fused_operand<T>{&arg.scalar(), 0, 0};
+
+            case 1:
+                {
+                    auto v = arg.vector();
+                    if (v.size() != columns)
+                    {
+                        break;
+                    }
+                    return fused_operand<T>{v.data(), 0, 1};
+                }
+
+            case 2:
+                {
+                    auto m = arg.matrix();
+                    if (m.rows() != rows || m.columns() != columns)
+                    {
+                        break;
+                    }
+                    return fused_operand<T>{m.data(), m.spacing(), 1};
+                }
+
+            default:
+                break;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_where::make_fused_operand",
+                util::generate_error_message(
+                    "operand can't be broadcast to the shape of the result",
+                    name, codename));
+        }
+
+        // The selection is written as a conditional expression to allow
+        // for the compiler to turn it into a vector blend.
+        template <typename Op, typename C, typename R>
+        void fused_where_kernel(R* result, std::size_t spacing,
+            std::size_t rows, std::size_t columns,
+            fused_operand<C> const& lhs, fused_operand<C> const& rhs,
+            fused_operand<R> const& a, fused_operand<R> const& b)
+        {
+            Op op;
+            for (std::size_t row = 0; row != rows; ++row)
+            {
+                R* r = result + row * spacing;
+                for (std::size_t column = 0; column != columns; ++column)
+                {
+                    r[column] = op(lhs(row, column), rhs(row, column)) ?
+                        a(row, column) : b(row, column);
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    fused_where::fused_where(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , kind_(compare_eq)
+    {
+        std::string func_name = detail::extract_fused_where_name(name_);
+        if (func_name == "__where_ne")
+        {
+            kind_ = compare_ne;
+        }
+        else if (func_name == "__where_lt")
+        {
+            kind_ = compare_lt;
+        }
+        else if (func_name == "__where_le")
+        {
+            kind_ = compare_le;
+        }
+        else if (func_name == "__where_gt")
+        {
+            kind_ = compare_gt;
+        }
+        else if (func_name == "__where_ge")
+        {
+            kind_ = compare_ge;
+        }
+        else
+        {
+            HPX_ASSERT(func_name == "__where_eq");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Op, typename C, typename R>
+    primitive_argument_type fused_where::fused_where_elements(
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+        primitive_argument_type&& a, primitive_argument_type&& b) const
+    {
+        std::size_t dims =
+            extract_largest_dimension(name_, codename_, lhs, rhs, a, b);
+        std::array<std::size_t, 2> sizes =
+            extract_largest_dimensions(name_, codename_, lhs, rhs, a, b);
+
+        // keep the (possibly converted) operands alive while the kernel runs
+        ir::node_data<C> lhs_data =
+            extract_node_data<C>(std::move(lhs), name_, codename_);
+        ir::node_data<C> rhs_data =
+            extract_node_data<C>(std::move(rhs), name_, codename_);
+        ir::node_data<R> a_data =
+            extract_node_data<R>(std::move(a), name_, codename_);
+        ir::node_data<R> b_data =
+            extract_node_data<R>(std::move(b), name_, codename_);
+
+        // The unfused comparison evaluates Op(element, other) if the left
+        // operand has fewer dimensions than the right one (i.e. 'x < v'
+        // compares the elements of v against x), keep that order.
+        bool swap_operands =
+            lhs_data.num_dimensions() < rhs_data.num_dimensions();
+        ir::node_data<C> const& first = swap_operands ? rhs_data : lhs_data;
+        ir::node_data<C> const& second = swap_operands ? lhs_data : rhs_data;
+
+        switch (dims)
+        {
+        case 0:
+            return primitive_argument_type{
+                Op{}(lhs_data.scalar(), rhs_data.scalar()) ?
+                    std::move(a_data) : std::move(b_data)};
+
+        case 1:
+            {
+                std::size_t size = sizes[1];
+                typename ir::node_data<R>::storage1d_type result(size);
+
+                detail::fused_where_kernel<Op>(result.data(), 0, 1, size,
+                    detail::make_fused_operand(
+                        first, 1, size, name_, codename_),
+                    detail::make_fused_operand(
+                        second, 1, size, name_, codename_),
+                    detail::make_fused_operand(
+                        a_data, 1, size, name_, codename_),
+                    detail::make_fused_operand(
+                        b_data, 1, size, name_, codename_));
+
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 2:
+            {
+                typename ir::node_data<R>::storage2d_type result(
+                    sizes[0], sizes[1]);
+
+                detail::fused_where_kernel<Op>(result.data(),
+                    result.spacing(), sizes[0], sizes[1],
+                    detail::make_fused_operand(
+                        first, sizes[0], sizes[1], name_, codename_),
+                    detail::make_fused_operand(
+                        second, sizes[0], sizes[1], name_, codename_),
+                    detail::make_fused_operand(
+                        a_data, sizes[0], sizes[1], name_, codename_),
+                    detail::make_fused_operand(
+                        b_data, sizes[0], sizes[1], name_, codename_));
+
+                return primitive_argument_type{std::move(result)};
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "fused_where::fused_where_elements",
+            util::generate_error_message(
+                "operands have unsupported number of dimensions",
+                name_, codename_));
+    }
+
+    template <typename C, typename R>
+    primitive_argument_type fused_where::fused_where_elements(
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+        primitive_argument_type&& a, primitive_argument_type&& b) const
+    {
+        switch (kind_)
+        {
+        case compare_eq:
+            return fused_where_elements<std::equal_to<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case compare_ne:
+            return fused_where_elements<std::not_equal_to<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case compare_lt:
+            return fused_where_elements<std::less<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case compare_le:
+            return fused_where_elements<std::less_equal<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case compare_gt:
+            return fused_where_elements<std::greater<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case compare_ge:
+            return fused_where_elements<std::greater_equal<C>, C, R>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "fused_where::fused_where_elements",
+            util::generate_error_message(
+                "unknown comparison operation", name_, codename_));
+    }
+
+    template <typename C>
+    primitive_argument_type fused_where::fused_where_elements(
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+        primitive_argument_type&& a, primitive_argument_type&& b) const
+    {
+        switch (extract_common_type(a, b))
+        {
+        case node_data_type_bool:
+            return fused_where_elements<C, std::uint8_t>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case node_data_type_int64:
+            return fused_where_elements<C, std::int64_t>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        case node_data_type_double:
+            return fused_where_elements<C, double>(
+                std::move(lhs), std::move(rhs), std::move(a), std::move(b));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "fused_where::fused_where_elements",
+            util::generate_error_message(
+                "the selected values have unsupported type",
+                name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool fused_where::is_fusable(primitive_argument_type const& lhs,
+        primitive_argument_type const& rhs, primitive_argument_type const& a,
+        primitive_argument_type const& b) const
+    {
+        if (extract_common_type(lhs, rhs) == node_data_type_unknown ||
+            extract_common_type(a, b) == node_data_type_unknown)
+        {
+            return false;
+        }
+
+        // the unfused comparison converts the other operand to a boolean
+        // (instead of the boolean to a number) if one of the operands is not
+        // a scalar
+        bool lhs_bool = is_boolean_operand_strict(lhs);
+        bool rhs_bool = is_boolean_operand_strict(rhs);
+        if (lhs_bool != rhs_bool)
+        {
+            return extract_numeric_value_dimension(lhs, name_, codename_) ==
+                    0 &&
+                extract_numeric_value_dimension(rhs, name_, codename_) == 0;
+        }
+        return true;
+    }
+
+    primitive_argument_type fused_where::unfused_where(
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs,
+        primitive_argument_type&& a, primitive_argument_type&& b) const
+    {
+        static char const* const comparison_names[] =
+        {
+            "__eq", "__ne", "__lt", "__le", "__gt", "__ge"
+        };
+
+        // the primitives are anonymous as they are created on each
+        // evaluation, registering their names would cause clashes
+        primitive_arguments_type comparison_operands;
+        comparison_operands.reserve(2);
+        comparison_operands.emplace_back(std::move(lhs));
+        comparison_operands.emplace_back(std::move(rhs));
+
+        primitive comparison = create_primitive_component(hpx::find_here(),
+            comparison_names[kind_], std::move(comparison_operands), "",
+            codename_);
+
+        primitive_arguments_type where_operands;
+        where_operands.reserve(3);
+        where_operands.emplace_back(comparison.eval(hpx::launch::sync));
+        where_operands.emplace_back(std::move(a));
+        where_operands.emplace_back(std::move(b));
+
+        primitive where = create_primitive_component(hpx::find_here(),
+            "where", std::move(where_operands), "", codename_);
+
+        return where.eval(hpx::launch::sync);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> fused_where::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_where::eval",
+                util::generate_error_message(
+                    "the fused where primitive requires exactly four "
+                    "operands",
+                    name_, codename_));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]) ||
+            !valid(operands[2]) || !valid(operands[3]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_where::eval",
+                util::generate_error_message(
+                    "the fused where primitive requires that the "
+                    "arguments given by the operands array are valid",
+                    name_, codename_));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& lhs,
+                primitive_argument_type&& rhs, primitive_argument_type&& a,
+                primitive_argument_type&& b)
+            -> primitive_argument_type
+            {
+                if (!this_->is_fusable(lhs, rhs, a, b))
+                {
+                    return this_->unfused_where(std::move(lhs),
+                        std::move(rhs), std::move(a), std::move(b));
+                }
+
+                switch (extract_common_type(lhs, rhs))
+                {
+                case node_data_type_bool:
+                    return this_->fused_where_elements<std::uint8_t>(
+                        std::move(lhs), std::move(rhs), std::move(a),
+                        std::move(b));
+
+                case node_data_type_int64:
+                    return this_->fused_where_elements<std::int64_t>(
+                        std::move(lhs), std::move(rhs), std::move(a),
+                        std::move(b));
+
+                case node_data_type_double:
+                    return this_->fused_where_elements<double>(
+                        std::move(lhs), std::move(rhs), std::move(a),
+                        std::move(b));
+
+                default:
+                    break;
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "fused_where::eval",
+                    util::generate_error_message(
+                        "the compared values have unsupported type",
+                        this_->name_, this_->codename_));
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            value_operand(operands[1], args, name_, codename_),
+            value_operand(operands[2], args, name_, codename_),
+            value_operand(operands[3], args, name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> fused_where::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
@@ -7,6 +7,7 @@
 #include <phylanx/ir/ranges.hpp>
 #include <phylanx/plugins/booleans/less_equal.hpp>
 #include <phylanx/plugins/booleans/comparison_impl.hpp>
+#include <phylanx/util/detail/comparison_simd.hpp>
 
 #include <hpx/include/util.hpp>
 
@@ -27,6 +28,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 return t1 <= t2;
             }
+
+            using simd_op = util::detail::less_equal_simd_op;
         };
     }
 
@@ -7,13 +7,17 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/nonzero_where.hpp>
+#include <phylanx/util/bit_mask.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -99,6 +103,131 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // minimal number of elements handled by one task while extracting
+        // the indices of the non-zero elements
+        constexpr std::size_t nonzero_min_block_size = 65536;
+
+        std::size_t nonzero_block_size(std::size_t size)
+        {
+            std::size_t num_blocks =
+                (size + nonzero_min_block_size - 1) / nonzero_min_block_size;
+
+            std::size_t max_blocks = 4 * hpx::get_os_thread_count();
+            if (num_blocks > max_blocks)
+            {
+                num_blocks = max_blocks;
+            }
+            if (num_blocks == 0)
+            {
+                num_blocks = 1;
+            }
+
+            // blocks start at word boundaries of the predicate masks
+            std::size_t const word_size = util::mask_bits_per_word;
+            std::size_t block_size = (size + num_blocks - 1) / num_blocks;
+            return (block_size + word_size - 1) / word_size * word_size;
+        }
+
+        // Invoke f(row, column, count) for the row segments covering the
+        // row-major element range [begin, end)
+        template <typename F>
+        void for_each_row_segment(std::size_t begin, std::size_t end,
+            std::size_t columns, F&& f)
+        {
+            while (begin != end)
+            {
+                std::size_t row = begin / columns;
+                std::size_t column = begin % columns;
+                std::size_t count = columns - column;
+                if (count > end - begin)
+                {
+                    count = end - begin;
+                }
+
+                f(row, column, count);
+                begin += count;
+            }
+        }
+
+        // Extract the positions of all elements for which is_nonzero(row,
+        // column) holds in row-major order. The elements are split into
+        // blocks which are processed in parallel in two passes: the first
+        // pass counts the non-zero elements of each block, the second pass
+        // stores their positions starting at the exclusive prefix sum of
+        // the counts. This allows for allocate(count) to be called exactly
+        // once before store(pos, row, column) is invoked for each element.
+        template <typename F, typename Allocate, typename Store>
+        void extract_nonzero(std::size_t rows, std::size_t columns,
+            F const& is_nonzero, Allocate&& allocate, Store const& store)
+        {
+            std::size_t size = rows * columns;
+            if (size == 0)
+            {
+                allocate(0);
+                return;
+            }
+
+            std::size_t block_size = nonzero_block_size(size);
+            std::size_t num_blocks = (size + block_size - 1) / block_size;
+
+            // offsets[b + 1] holds the number of non-zero elements in block b
+            std::vector<std::size_t> offsets(num_blocks + 1, 0);
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_blocks,
+                [&](std::size_t b)
+                {
+                    std::size_t begin = b * block_size;
+                    std::size_t end = (std::min)(begin + block_size, size);
+
+                    std::size_t count = 0;
+                    for_each_row_segment(begin, end, columns,
+                        [&](std::size_t row, std::size_t column,
+                            std::size_t n)
+                        {
+                            count += util::mask_count(n,
+                                [&](std::size_t j)
+                                {
+                                    return is_nonzero(row, column + j);
+                                });
+                        });
+                    offsets[b + 1] = count;
+                });
+
+            // turn the counts into the start offsets of the blocks, the
+            // number of blocks is small
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            allocate(offsets[num_blocks]);
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_blocks,
+                [&](std::size_t b)
+                {
+                    std::size_t begin = b * block_size;
+                    std::size_t end = (std::min)(begin + block_size, size);
+
+                    std::size_t pos = offsets[b];
+                    for_each_row_segment(begin, end, columns,
+                        [&](std::size_t row, std::size_t column,
+                            std::size_t n)
+                        {
+                            util::mask_for_each(n,
+                                [&](std::size_t j)
+                                {
+                                    return is_nonzero(row, column + j);
+                                },
+                                [&](std::size_t j)
+                                {
+                                    store(pos++, row, column + j);
+                                });
+                        });
+                });
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     primitive_argument_type nonzero_where::nonzero_elements(
@@ -124,17 +253,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case 1:
             {
                 auto v = op.vector();
-                storage1d_type indices(v.size());
-                std::size_t count = 0;
-                for (std::size_t i = 0; i != v.size(); ++i)
-                {
-                    if (v[i] != T(0))
+
+                storage1d_type indices;
+                detail::extract_nonzero(1, v.size(),
+                    [&](std::size_t, std::size_t j)
                     {
-                        indices[count++] = std::int64_t(i);
-                    }
-                }
-                indices.resize(count);
-                indices.shrinkToFit();
+                        return v[j] != T(0);
+                    },
+                    [&](std::size_t count)
+                    {
+                        indices.resize(count, false);
+                    },
+                    [&](std::size_t pos, std::size_t, std::size_t j)
+                    {
+                        indices[pos] = std::int64_t(j);
+                    });
 
                 primitive_arguments_type result;
                 result.reserve(1);
@@ -145,27 +278,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case 2:
             {
                 auto m = op.matrix();
-                storage1d_type indices_row(op.size());
-                storage1d_type indices_column(op.size());
-                std::size_t count = 0;
 
-                for (std::size_t i = 0; i != m.rows(); ++i)
-                {
-                    for (std::size_t j = 0; j != m.columns(); ++j)
+                storage1d_type indices_row;
+                storage1d_type indices_column;
+                detail::extract_nonzero(m.rows(), m.columns(),
+                    [&](std::size_t i, std::size_t j)
                     {
-                        if (m(i, j) != T(0))
-                        {
-                            indices_row[count] = std::int64_t(i);
-                            indices_column[count++] = std::int64_t(j);
-                        }
-                    }
-                }
-
-                indices_row.resize(count);
-                indices_row.shrinkToFit();
-
-                indices_column.resize(count);
-                indices_column.shrinkToFit();
+                        return m(i, j) != T(0);
+                    },
+                    [&](std::size_t count)
+                    {
+                        indices_row.resize(count, false);
+                        indices_column.resize(count, false);
+                    },
+                    [&](std::size_t pos, std::size_t i, std::size_t j)
+                    {
+                        indices_row[pos] = std::int64_t(i);
+                        indices_column[pos] = std::int64_t(j);
+                    });
 
                 primitive_arguments_type result;
                 result.reserve(2);
@@ -7,6 +7,7 @@
 #include <phylanx/ir/ranges.hpp>
 #include <phylanx/plugins/booleans/or_operation.hpp>
 #include <phylanx/plugins/booleans/logical_operation_impl.hpp>
+#include <phylanx/util/detail/logical_simd.hpp>
 
 #include <hpx/include/util.hpp>
 
@@ -26,6 +27,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 return lhs || rhs;
             }
+
+            using simd_op = util::detail::or_simd_op;
         };
     }
 
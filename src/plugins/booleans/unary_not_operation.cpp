@@ -6,6 +6,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/unary_not_operation.hpp>
+#include <phylanx/util/detail/logical_simd.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -60,18 +61,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 ir::node_data<std::uint8_t>{ops.scalar() == T(0)}};
 
         case 1:
-            // TODO: SIMD functionality should be added, blaze implementation
-            // is not currently available
+            if (ops.is_ref())
+            {
+                ops = blaze::map(ops.vector(),
+                    util::detail::predicate_simd<util::detail::not_simd_op>{});
+            }
+            else
+            {
+                ops.vector() = blaze::map(ops.vector(),
+                    util::detail::predicate_simd<util::detail::not_simd_op>{});
+            }
             return primitive_argument_type{
-                ir::node_data<std::uint8_t>{blaze::map(
-                    ops.vector(), [](T x) { return x == T(0); })}};
+                ir::node_data<std::uint8_t>{std::move(ops)}};
 
         case 2:
-            // TODO: SIMD functionality should be added, blaze implementation
-            // is not currently available
+            if (ops.is_ref())
+            {
+                ops = blaze::map(ops.matrix(),
+                    util::detail::predicate_simd<util::detail::not_simd_op>{});
+            }
+            else
+            {
+                ops.matrix() = blaze::map(ops.matrix(),
+                    util::detail::predicate_simd<util::detail::not_simd_op>{});
+            }
             return primitive_argument_type{
-                ir::node_data<std::uint8_t>{blaze::map(
-                    ops.matrix(), [](T x) { return x == T(0); })}};
+                ir::node_data<std::uint8_t>{std::move(ops)}};
 
         default:
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -0,0 +1,226 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/controls/parallel_for_each.hpp>
+#include <phylanx/ir/ranges.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const parallel_for_each::match_data =
+    {
+        hpx::util::make_tuple("parallel_for_each",
+            std::vector<std::string>{"parallel_for_each(_1, _2, __3)"},
+            &create_parallel_for_each, &create_primitive<parallel_for_each>,
+            "func, range, grain_size\n"
+            "The parallel_for_each primitive calls a function `func` for\n"
+            "each item in the iterator. The invocations are independent of\n"
+            "each other and are executed concurrently.\n"
+            "Args:\n"
+            "\n"
+            "    func (function): a function that takes one argument\n"
+            "    range (iter): an iterator\n"
+            "    grain_size (int, optional): the number of items handled by\n"
+            "        one task, by default the items are evenly distributed\n"
+            "        over the available cores\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "  `nil`\n"
+            "\n"
+            "Examples:\n"
+            "\n"
+            "    @Phylanx\n"
+            "    def foo(a):\n"
+            "        for i in prange(0, 100, grain_size=10):\n"
+            "            a[i] = i * i\n"
+            "\n"
+            "Is lowered to a `parallel_for_each` computing all elements of\n"
+            "`a` concurrently in chunks of 10 elements."
+        )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // by default the items are distributed over four chunks per core
+        std::size_t parallel_for_each_grain_size(std::size_t size)
+        {
+            std::size_t const num_chunks = 4 * hpx::get_os_thread_count();
+            std::size_t const grain_size =
+                (size + num_chunks - 1) / num_chunks;
+            return grain_size == 0 ? 1 : grain_size;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    parallel_for_each::parallel_for_each(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    hpx::future<primitive_argument_type> parallel_for_each::iterate(
+        primitive_argument_type&& bound_func, ir::range&& list,
+        std::int64_t grain_size, eval_mode mode) const
+    {
+        primitive const* p = util::get_if<primitive>(&bound_func);
+        if (p == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::iterate",
+                util::generate_error_message(
+                    "the first argument to parallel_for_each must "
+                        "resolve to an invocable object",
+                    name_, codename_));
+        }
+
+        if (grain_size < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::iterate",
+                util::generate_error_message(
+                    "the grain size given to parallel_for_each must not "
+                        "be negative",
+                    name_, codename_));
+        }
+
+        // the chunks need random access to the items of the range
+        auto items = std::make_shared<primitive_arguments_type>(list.copy());
+        std::size_t const size = items->size();
+
+        std::size_t const chunk_size = grain_size != 0 ?
+            std::size_t(grain_size) :
+            detail::parallel_for_each_grain_size(size);
+
+        std::vector<hpx::future<void>> chunks;
+        chunks.reserve((size + chunk_size - 1) / chunk_size);
+
+        for (std::size_t begin = 0; begin < size; begin += chunk_size)
+        {
+            std::size_t const end = (std::min)(begin + chunk_size, size);
+            chunks.push_back(hpx::async(
+                [func = *p, items, begin, end, mode]()
+                {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        func.eval(hpx::launch::sync, std::move((*items)[i]),
+                            mode);
+                    }
+                }));
+        }
+
+        return hpx::when_all(std::move(chunks)).then(hpx::launch::sync,
+            [](hpx::future<std::vector<hpx::future<void>>>&& f)
+            -> primitive_argument_type
+            {
+                // rethrow exceptions, if any
+                for (auto& chunk : f.get())
+                {
+                    chunk.get();
+                }
+                return primitive_argument_type{};
+            });
+    }
+
+    hpx::future<primitive_argument_type> parallel_for_each::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_mode mode) const
+    {
+        if (operands.size() != 2 && operands.size() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::eval",
+                util::generate_error_message(
+                    "the parallel_for_each primitive requires "
+                        "two or three operands",
+                    name_, codename_));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "parallel_for_each::eval",
+                    util::generate_error_message(
+                        "the parallel_for_each primitive requires that the "
+                            "arguments given by the operands array "
+                            "are valid",
+                        name_, codename_));
+            }
+        }
+
+        // the first argument must be an invokable
+        if (util::get_if<primitive>(&operands_[0]) == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::eval",
+                util::generate_error_message(
+                    "the first argument to parallel_for_each must be an "
+                        "invocable object", name_, codename_));
+        }
+
+        mode = eval_mode(mode & ~eval_dont_wrap_functions);
+
+        auto this_ = this->shared_from_this();
+        if (operands.size() == 2)
+        {
+            return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+                [this_ = std::move(this_), mode](
+                        primitive_argument_type&& bound_func, ir::range&& list)
+                -> hpx::future<primitive_argument_type>
+                {
+                    return this_->iterate(std::move(bound_func),
+                        std::move(list), 0, mode);
+                }),
+                value_operand(operands_[0], args, name_, codename_,
+                    eval_dont_evaluate_lambdas),
+                list_operand(operands_[1], args, name_, codename_));
+        }
+
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), mode](
+                    primitive_argument_type&& bound_func, ir::range&& list,
+                    std::int64_t grain_size)
+            -> hpx::future<primitive_argument_type>
+            {
+                return this_->iterate(std::move(bound_func),
+                    std::move(list), grain_size, mode);
+            }),
+            value_operand(operands_[0], args, name_, codename_,
+                eval_dont_evaluate_lambdas),
+            list_operand(operands_[1], args, name_, codename_),
+            scalar_integer_operand_strict(
+                operands_[2], args, name_, codename_));
+    }
+
+    // Start iteration over given parallel_for_each statement
+    hpx::future<primitive_argument_type> parallel_for_each::eval(
+        primitive_arguments_type const& args, eval_mode mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs, mode);
+        }
+        return eval(this->operands(), args, mode);
+    }
+}}}
@@ -0,0 +1,599 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/collective_operation.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        // Each locality holds a mailbox receiving the values sent to it by
+        // the other localities participating in a collective operation.
+        // Values are matched by a key which is unique for each collective
+        // operation, its invocation, and the sending locality.
+        class collective_mailbox
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            struct slot
+            {
+                slot()
+                  : retrieved_(false)
+                  , delivered_(false)
+                {}
+
+                hpx::lcos::local::promise<primitive_argument_type> promise_;
+                bool retrieved_;
+                bool delivered_;
+            };
+
+        public:
+            hpx::future<primitive_argument_type> receive(
+                std::string const& key)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                auto it = slots_.emplace(key, slot{}).first;
+                hpx::future<primitive_argument_type> f =
+                    it->second.promise_.get_future();
+
+                it->second.retrieved_ = true;
+                if (it->second.delivered_)
+                {
+                    slots_.erase(it);
+                }
+                return f;
+            }
+
+            void deliver(
+                std::string const& key, primitive_argument_type&& value)
+            {
+                hpx::lcos::local::promise<primitive_argument_type> p;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+
+                    auto it = slots_.emplace(key, slot{}).first;
+                    if (!it->second.retrieved_)
+                    {
+                        // nobody waits for the value yet
+                        it->second.delivered_ = true;
+                        it->second.promise_.set_value(std::move(value));
+                        return;
+                    }
+
+                    p = std::move(it->second.promise_);
+                    slots_.erase(it);
+                }
+
+                // make the value available outside of the lock as this may
+                // run continuations
+                p.set_value(std::move(value));
+            }
+
+        private:
+            mutex_type mtx_;
+            std::map<std::string, slot> slots_;
+        };
+
+        collective_mailbox& get_collective_mailbox()
+        {
+            static collective_mailbox mailbox;
+            return mailbox;
+        }
+
+        void deliver_collective_value(
+            std::string const& key, primitive_argument_type value)
+        {
+            get_collective_mailbox().deliver(key, std::move(value));
+        }
+    }
+}}}
+
+HPX_PLAIN_ACTION(
+    phylanx::execution_tree::primitives::detail::deliver_collective_value,
+    deliver_collective_value_action);
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const collective_operation::match_data =
+    {
+        hpx::util::make_tuple("all_reduce",
+            std::vector<std::string>{"all_reduce(_1, _2)", "all_reduce(_1)"},
+            &create_all_reduce_operation,
+            &create_primitive<collective_operation>,
+            "x, op\n"
+            "Args:\n"
+            "\n"
+            "    x (number, vector, or matrix) : the contribution of this "
+            "locality\n"
+            "    op (optional, string) : the reduction to apply, one of "
+            "'sum', 'prod', 'min', or 'max' (default: 'sum')\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The elementwise reduction of the values of `x` of all "
+            "localities, the result is available on all localities. All "
+            "localities must evaluate this primitive."),
+
+        hpx::util::make_tuple("broadcast",
+            std::vector<std::string>{"broadcast(_1, _2)", "broadcast(_1)"},
+            &create_broadcast_operation,
+            &create_primitive<collective_operation>,
+            "x, root\n"
+            "Args:\n"
+            "\n"
+            "    x (any) : the value to send (only used on the root "
+            "locality)\n"
+            "    root (optional, int) : the locality sending its value "
+            "(default: 0)\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The value of `x` on the root locality, the result is available "
+            "on all localities. All localities must evaluate this "
+            "primitive."),
+
+        hpx::util::make_tuple("gather",
+            std::vector<std::string>{"gather(_1, _2)", "gather(_1)"},
+            &create_gather_operation,
+            &create_primitive<collective_operation>,
+            "x, root\n"
+            "Args:\n"
+            "\n"
+            "    x (any) : the contribution of this locality\n"
+            "    root (optional, int) : the locality collecting the values "
+            "(default: 0)\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "On the root locality a list holding the values of `x` of all "
+            "localities ordered by locality id, nil on all other "
+            "localities. All localities must evaluate this primitive.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        collective_operation::collective_type extract_collective_type(
+            std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            std::string function_name;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                function_name = name.substr(0, name.find_first_of("$"));
+            }
+            else
+            {
+                function_name = std::move(name_parts.primitive);
+            }
+
+            if (function_name == "broadcast")
+            {
+                return collective_operation::broadcast_collective;
+            }
+            if (function_name == "gather")
+            {
+                return collective_operation::gather_collective;
+            }
+            return collective_operation::all_reduce_collective;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::uint32_t this_site()
+        {
+            return hpx::get_locality_id();
+        }
+
+        std::uint32_t num_sites()
+        {
+            return hpx::get_num_localities(hpx::launch::sync);
+        }
+
+        hpx::future<void> send_collective_value(std::uint32_t site,
+            std::string const& key, primitive_argument_type value)
+        {
+            return hpx::async(deliver_collective_value_action{},
+                hpx::naming::get_id_from_locality_id(site), key,
+                std::move(value));
+        }
+
+        primitive_argument_type receive_collective_value(
+            std::string const& key)
+        {
+            return get_collective_mailbox().receive(key).get();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct sum_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs + rhs;
+            }
+        };
+
+        struct prod_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs * rhs;
+            }
+        };
+
+        struct min_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::min)(lhs, rhs);
+            }
+        };
+
+        struct max_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::max)(lhs, rhs);
+            }
+        };
+
+        // combine the given values in place, operating directly on the
+        // node_data instances
+        template <typename T, typename Op>
+        ir::node_data<T> combine_values(ir::node_data<T>&& lhs,
+            ir::node_data<T>&& rhs, Op op, std::string const& name,
+            std::string const& codename)
+        {
+            if (lhs.dimensions() != rhs.dimensions())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "collective_operation::all_reduce",
+                    util::generate_error_message(
+                        "the values contributed by the localities must have "
+                        "the same shape",
+                        name, codename));
+            }
+
+            switch (lhs.num_dimensions())
+            {
+            case 0:
+                lhs.scalar() = op(lhs.scalar(), rhs.scalar());
+                break;
+
+            case 1:
+                if (lhs.is_ref())
+                {
+                    lhs = blaze::map(lhs.vector(), rhs.vector(), op);
+                }
+                else
+                {
+                    lhs.vector() = blaze::map(lhs.vector(), rhs.vector(), op);
+                }
+                break;
+
+            case 2:
+                if (lhs.is_ref())
+                {
+                    lhs = blaze::map(lhs.matrix(), rhs.matrix(), op);
+                }
+                else
+                {
+                    lhs.matrix() = blaze::map(lhs.matrix(), rhs.matrix(), op);
+                }
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "collective_operation::all_reduce",
+                    util::generate_error_message(
+                        "the values have an unsupported number of dimensions",
+                        name, codename));
+            }
+            return std::move(lhs);
+        }
+
+        template <typename T>
+        primitive_argument_type combine_values(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs, std::string const& op,
+            std::string const& name, std::string const& codename)
+        {
+            ir::node_data<T> l =
+                extract_node_data<T>(std::move(lhs), name, codename);
+            ir::node_data<T> r =
+                extract_node_data<T>(std::move(rhs), name, codename);
+
+            if (op == "sum")
+            {
+                return primitive_argument_type{combine_values(
+                    std::move(l), std::move(r), sum_op{}, name, codename)};
+            }
+            if (op == "prod")
+            {
+                return primitive_argument_type{combine_values(
+                    std::move(l), std::move(r), prod_op{}, name, codename)};
+            }
+            if (op == "min")
+            {
+                return primitive_argument_type{combine_values(
+                    std::move(l), std::move(r), min_op{}, name, codename)};
+            }
+            return primitive_argument_type{combine_values(
+                std::move(l), std::move(r), max_op{}, name, codename)};
+        }
+
+        // boolean values are reduced as integers
+        primitive_argument_type combine_values(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs, std::string const& op,
+            std::string const& name, std::string const& codename)
+        {
+            if (extract_common_type(lhs, rhs) == node_data_type_double)
+            {
+                return combine_values<double>(
+                    std::move(lhs), std::move(rhs), op, name, codename);
+            }
+            return combine_values<std::int64_t>(
+                std::move(lhs), std::move(rhs), op, name, codename);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    collective_operation::collective_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , type_(detail::extract_collective_type(name_))
+      , generation_(0)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The values are reduced towards locality 0 and the result is sent back
+    // along a binomial tree, each locality sends and receives at most
+    // log2(N) messages.
+    primitive_argument_type collective_operation::all_reduce(
+        primitive_argument_type&& value, std::string const& op,
+        std::string const& key) const
+    {
+        std::uint32_t site = detail::this_site();
+        std::uint32_t num_sites = detail::num_sites();
+
+        std::uint32_t mask = 1;
+        while (mask < num_sites)
+        {
+            if ((site & mask) != 0)
+            {
+                detail::send_collective_value(site - mask,
+                    key + "/reduce/" + std::to_string(site),
+                    std::move(value)).get();
+                break;
+            }
+
+            if (site + mask < num_sites)
+            {
+                value = detail::combine_values(std::move(value),
+                    detail::receive_collective_value(key + "/reduce/" +
+                        std::to_string(site + mask)),
+                    op, name_, codename_);
+            }
+            mask <<= 1;
+        }
+
+        return broadcast(std::move(value), 0, key);
+    }
+
+    primitive_argument_type collective_operation::broadcast(
+        primitive_argument_type&& value, std::uint32_t root,
+        std::string const& key) const
+    {
+        std::uint32_t num_sites = detail::num_sites();
+        std::uint32_t site =
+            (detail::this_site() + num_sites - root) % num_sites;
+
+        // receive the value from our parent in the tree
+        std::uint32_t mask = 1;
+        while (mask < num_sites)
+        {
+            if ((site & mask) != 0)
+            {
+                value = detail::receive_collective_value(key + "/broadcast");
+                break;
+            }
+            mask <<= 1;
+        }
+
+        // forward it to our children
+        std::vector<hpx::future<void>> sends;
+        for (mask >>= 1; mask != 0; mask >>= 1)
+        {
+            if (site + mask < num_sites)
+            {
+                sends.push_back(detail::send_collective_value(
+                    (site + mask + root) % num_sites, key + "/broadcast",
+                    value));
+            }
+        }
+        hpx::wait_all(sends);
+
+        for (auto& f : sends)
+        {
+            f.get();        // rethrow exceptions
+        }
+        return std::move(value);
+    }
+
+    primitive_argument_type collective_operation::gather(
+        primitive_argument_type&& value, std::uint32_t root,
+        std::string const& key) const
+    {
+        std::uint32_t site = detail::this_site();
+        std::uint32_t num_sites = detail::num_sites();
+
+        if (site != root)
+        {
+            detail::send_collective_value(root,
+                key + "/gather/" + std::to_string(site),
+                std::move(value)).get();
+            return primitive_argument_type{};
+        }
+
+        std::vector<hpx::future<primitive_argument_type>> values;
+        values.reserve(num_sites);
+        for (std::uint32_t i = 0; i != num_sites; ++i)
+        {
+            if (i == root)
+            {
+                values.push_back(hpx::make_ready_future(std::move(value)));
+            }
+            else
+            {
+                values.push_back(detail::get_collective_mailbox().receive(
+                    key + "/gather/" + std::to_string(i)));
+            }
+        }
+
+        primitive_arguments_type result;
+        result.reserve(num_sites);
+        for (auto& f : values)
+        {
+            result.push_back(f.get());
+        }
+        return primitive_argument_type{std::move(result)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type collective_operation::collective(
+        primitive_argument_type&& value, primitive_argument_type&& param) const
+    {
+        // all localities evaluate this primitive the same number of times
+        std::string key = name_ + "/" + std::to_string(generation_++);
+
+        if (type_ == all_reduce_collective)
+        {
+            std::string op = "sum";
+            if (valid(param))
+            {
+                op = extract_string_value(std::move(param), name_, codename_);
+                if (op != "sum" && op != "prod" && op != "min" && op != "max")
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "collective_operation::collective",
+                        generate_error_message(
+                            "the reduction operation must be one of 'sum', "
+                            "'prod', 'min', or 'max'"));
+                }
+            }
+            return all_reduce(std::move(value), op, key);
+        }
+
+        std::int64_t root = 0;
+        if (valid(param))
+        {
+            root = extract_scalar_integer_value(
+                std::move(param), name_, codename_);
+        }
+        if (root < 0 || root >= std::int64_t(detail::num_sites()))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "collective_operation::collective",
+                generate_error_message(
+                    "the root locality does not exist"));
+        }
+
+        if (type_ == broadcast_collective)
+        {
+            return broadcast(std::move(value), std::uint32_t(root), key);
+        }
+        return gather(std::move(value), std::uint32_t(root), key);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> collective_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.empty() || operands.size() > 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "collective_operation::eval",
+                generate_error_message(
+                    "the collective operations require one or two "
+                    "operands"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "collective_operation::eval",
+                    generate_error_message(
+                        "the collective operations require that the "
+                        "arguments given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        if (operands.size() == 1)
+        {
+            return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_argument_type&& value)
+                -> primitive_argument_type
+                {
+                    return this_->collective(
+                        std::move(value), primitive_argument_type{});
+                }),
+                value_operand(operands[0], args, name_, codename_));
+        }
+
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& value,
+                primitive_argument_type&& param)
+            -> primitive_argument_type
+            {
+                return this_->collective(std::move(value), std::move(param));
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            value_operand(operands[1], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> collective_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
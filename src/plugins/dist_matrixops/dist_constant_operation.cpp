@@ -0,0 +1,192 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_constant_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_constant_operation::match_data =
+    {
+        hpx::util::make_tuple("constant_d",
+            std::vector<std::string>{
+                "constant_d(_1, _2, _3)", "constant_d(_1, _2)"},
+            &create_dist_constant_operation,
+            &create_primitive<dist_constant_operation>,
+            "value, shape, n\n"
+            "Args:\n"
+            "\n"
+            "    value (float) : the value of all elements\n"
+            "    shape (list) : the number of elements of the vector, or "
+            "the number of rows and columns of the matrix\n"
+            "    n (optional, int) : the number of partitions, defaults to "
+            "the number of localities\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "A partitioned array of the given shape with each element equal "
+            "to `value`, split into `n` blocks of rows (elements for vectors) "
+            "like partition() would. Each block is created on the locality "
+            "owning it.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_constant_operation::dist_constant_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_constant_operation::constant(
+        primitive_argument_type&& value, ir::range&& shape,
+        std::size_t num_partitions) const
+    {
+        if (extract_numeric_value_dimension(value, name_, codename_) != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_constant_operation::constant",
+                generate_error_message(
+                    "the first argument must be a literal scalar value"));
+        }
+
+        if (shape.empty() || shape.size() > 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_constant_operation::constant",
+                generate_error_message(
+                    "the shape must have one (vectors) or two (matrices) "
+                    "entries"));
+        }
+
+        partitioned_array result;
+        result.dimensions = shape.size();
+
+        auto it = shape.begin();
+        result.size =
+            std::size_t(extract_scalar_integer_value(*it, name_, codename_));
+        result.columns = result.dimensions == 1 ? 0 :
+            std::size_t(extract_scalar_integer_value(*++it, name_, codename_));
+
+        if (result.size == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_constant_operation::constant",
+                generate_error_message(
+                    "the constant_d primitive can't create an empty array"));
+        }
+
+        result.partitions =
+            make_partition_layout(result.size, num_partitions);
+
+        std::vector<hpx::future<primitive>> tiles;
+        tiles.reserve(result.partitions.size());
+        for (auto const& part : result.partitions)
+        {
+            primitive_arguments_type tile_shape;
+            tile_shape.reserve(2);
+            tile_shape.emplace_back(std::int64_t(part.size));
+            if (result.dimensions == 2)
+            {
+                tile_shape.emplace_back(std::int64_t(result.columns));
+            }
+
+            primitive_arguments_type ops;
+            ops.reserve(2);
+            ops.emplace_back(value);
+            ops.emplace_back(std::move(tile_shape));
+
+            tiles.push_back(create_partition_tile(
+                part, "constant", std::move(ops), codename_));
+        }
+
+        for (std::size_t i = 0; i != tiles.size(); ++i)
+        {
+            result.partitions[i].tile = tiles[i].get();
+        }
+        return make_partitioned_array(std::move(result));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_constant_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 2 && operands.size() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_constant_operation::eval",
+                generate_error_message(
+                    "the constant_d primitive requires two or three "
+                    "operands"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_constant_operation::eval",
+                    generate_error_message(
+                        "the constant_d primitive requires that the "
+                        "arguments given by the operands array are valid"));
+            }
+        }
+
+        hpx::future<std::int64_t> num_partitions =
+            operands.size() == 3 ?
+                scalar_integer_operand_strict(
+                    operands[2], args, name_, codename_) :
+                hpx::make_ready_future(std::int64_t(0));
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& value,
+                ir::range&& shape, std::int64_t num_partitions)
+            -> primitive_argument_type
+            {
+                if (num_partitions < 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_constant_operation::eval",
+                        this_->generate_error_message(
+                            "the number of partitions must not be "
+                            "negative"));
+                }
+                return this_->constant(std::move(value), std::move(shape),
+                    std::size_t(num_partitions));
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            list_operand(operands[1], args, name_, codename_),
+            std::move(num_partitions));
+    }
+
+    hpx::future<primitive_argument_type> dist_constant_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
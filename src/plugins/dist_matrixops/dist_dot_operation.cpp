@@ -0,0 +1,333 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_dot_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_dot_operation::match_data =
+    {
+        hpx::util::make_tuple("dot_d",
+            std::vector<std::string>{"dot_d(_1, _2)"},
+            &create_dist_dot_operation, &create_primitive<dist_dot_operation>,
+            "a, b\n"
+            "Args:\n"
+            "\n"
+            "    a (partitioned array or array) : the left hand side\n"
+            "    b (partitioned array or array) : the right hand side\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The dot product of `a` and `b`. If `a` is a partitioned matrix "
+            "the result is partitioned like `a`, products reducing over the "
+            "partitioned dimension (vector-vector, vector-matrix) are "
+            "computed from partial products on the owning localities. "
+            "Scaling a partitioned array by a scalar is done tile by tile. "
+            "A partitioned right hand side is collected if `a` is a "
+            "partitioned matrix.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_dot_operation::dist_dot_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // dot(a, b) where the rows of the matrix 'a' are partitioned, and
+        // 'b' is a local value which is sent to all partitions. This also
+        // scales a partitioned vector 'a' by a scalar 'b'.
+        primitive_argument_type dot_partitioned_matrix(partitioned_array&& a,
+            primitive_argument_type&& b, std::string const& name,
+            std::string const& codename)
+        {
+            std::size_t dims =
+                extract_numeric_value_dimension(b, name, codename);
+            std::array<std::size_t, 2> sizes =
+                extract_numeric_value_dimensions(b, name, codename);
+
+            std::vector<hpx::future<primitive>> tiles;
+            tiles.reserve(a.partitions.size());
+            for (auto const& part : a.partitions)
+            {
+                primitive_arguments_type ops;
+                ops.reserve(2);
+                ops.emplace_back(part.tile);
+                ops.emplace_back(b);
+
+                tiles.push_back(create_partition_tile(
+                    part, "dot", std::move(ops), codename));
+            }
+
+            for (std::size_t i = 0; i != tiles.size(); ++i)
+            {
+                a.partitions[i].tile = tiles[i].get();
+            }
+
+            // matrix-vector products produce a partitioned vector, scaling
+            // by a scalar keeps the shape
+            if (dims == 1)
+            {
+                a.dimensions = 1;
+                a.columns = 0;
+            }
+            else if (dims == 2)
+            {
+                a.columns = sizes[1];
+            }
+            return make_partitioned_array(std::move(a));
+        }
+
+        // dot(a, b) where the partitioned dimension is reduced, 'a' is a
+        // (partitioned or local) vector, 'b' is a partitioned vector or
+        // matrix
+        primitive_argument_type dot_reduce_partitions(
+            primitive_argument_type&& a, partitioned_array&& b,
+            std::string const& name, std::string const& codename)
+        {
+            bool a_partitioned = is_partitioned_array(a);
+
+            partitioned_array a_arr;
+            if (a_partitioned)
+            {
+                a_arr = extract_partitioned_array(a, name, codename);
+                if (a_arr.dimensions != 1 || !same_layout(a_arr,
+                        partitioned_array{1, b.size, 0, b.partitions}))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_dot_operation::eval",
+                        util::generate_error_message(
+                            "the partitioned operands must be split into the "
+                            "same partitions",
+                            name, codename));
+                }
+            }
+            else if (extract_numeric_value_dimension(a, name, codename) != 1 ||
+                extract_numeric_value_dimensions(a, name, codename)[1] !=
+                    b.size)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_dot_operation::eval",
+                    util::generate_error_message(
+                        "the operands have incompatible number of dimensions",
+                        name, codename));
+            }
+
+            std::vector<hpx::future<primitive_argument_type>> partials;
+            partials.reserve(b.partitions.size());
+            for (std::size_t i = 0; i != b.partitions.size(); ++i)
+            {
+                auto const& part = b.partitions[i];
+
+                primitive_arguments_type ops;
+                ops.reserve(2);
+                if (a_partitioned)
+                {
+                    ops.emplace_back(a_arr.partitions[i].tile);
+                }
+                else
+                {
+                    ops.emplace_back(extract_partition_rows(
+                        a, part.begin, part.size, name, codename));
+                }
+                ops.emplace_back(part.tile);
+
+                partials.push_back(evaluate_on_partition(
+                    part, "dot", std::move(ops), codename));
+            }
+
+            primitive_arguments_type results;
+            results.reserve(partials.size());
+            for (auto& f : partials)
+            {
+                results.push_back(f.get());
+            }
+            return add_partial_results(std::move(results), codename);
+        }
+
+        // dot(a, b) where 'a' is a partitioned vector and 'b' is a local
+        // matrix, the partial products of each partition with the
+        // corresponding rows of 'b' are added up
+        primitive_argument_type dot_partitioned_vector_matrix(
+            partitioned_array&& a, primitive_argument_type&& b,
+            std::string const& name, std::string const& codename)
+        {
+            if (extract_numeric_value_dimensions(b, name, codename)[0] !=
+                a.size)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_dot_operation::eval",
+                    util::generate_error_message(
+                        "the operands have incompatible number of dimensions",
+                        name, codename));
+            }
+
+            std::vector<hpx::future<primitive_argument_type>> partials;
+            partials.reserve(a.partitions.size());
+            for (auto const& part : a.partitions)
+            {
+                primitive_arguments_type ops;
+                ops.reserve(2);
+                ops.emplace_back(part.tile);
+                ops.emplace_back(extract_partition_rows(
+                    b, part.begin, part.size, name, codename));
+
+                partials.push_back(evaluate_on_partition(
+                    part, "dot", std::move(ops), codename));
+            }
+
+            primitive_arguments_type results;
+            results.reserve(partials.size());
+            for (auto& f : partials)
+            {
+                results.push_back(f.get());
+            }
+            return add_partial_results(std::move(results), codename);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_dot_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_dot_operation::eval",
+                generate_error_message(
+                    "the dot_d primitive requires exactly two operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_dot_operation::eval",
+                generate_error_message(
+                    "the dot_d primitive requires that the arguments given "
+                    "by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& lhs,
+                primitive_argument_type&& rhs)
+            -> primitive_argument_type
+            {
+                std::string const& name = this_->name_;
+                std::string const& codename = this_->codename_;
+
+                bool lhs_partitioned = is_partitioned_array(lhs);
+                bool rhs_partitioned = is_partitioned_array(rhs);
+
+                if (lhs_partitioned)
+                {
+                    partitioned_array a =
+                        extract_partitioned_array(lhs, name, codename);
+                    if (a.dimensions == 2)
+                    {
+                        if (rhs_partitioned)
+                        {
+                            rhs = gather_partitioned_array(
+                                extract_partitioned_array(
+                                    rhs, name, codename),
+                                name, codename);
+                        }
+                        return detail::dot_partitioned_matrix(
+                            std::move(a), std::move(rhs), name, codename);
+                    }
+
+                    if (!rhs_partitioned)
+                    {
+                        switch (extract_numeric_value_dimension(
+                            rhs, name, codename))
+                        {
+                        case 0:
+                            return detail::dot_partitioned_matrix(
+                                std::move(a), std::move(rhs), name, codename);
+
+                        case 2:
+                            return detail::dot_partitioned_vector_matrix(
+                                std::move(a), std::move(rhs), name, codename);
+
+                        default:
+                            // vector-vector products are symmetric
+                            return detail::dot_reduce_partitions(
+                                std::move(rhs), std::move(a), name, codename);
+                        }
+                    }
+                }
+
+                if (rhs_partitioned)
+                {
+                    if (!lhs_partitioned &&
+                        extract_numeric_value_dimension(
+                            lhs, name, codename) == 0)
+                    {
+                        // scaling by a scalar is symmetric
+                        return detail::dot_partitioned_matrix(
+                            extract_partitioned_array(rhs, name, codename),
+                            std::move(lhs), name, codename);
+                    }
+
+                    if (lhs_partitioned ||
+                        extract_numeric_value_dimension(
+                            lhs, name, codename) == 1)
+                    {
+                        return detail::dot_reduce_partitions(std::move(lhs),
+                            extract_partitioned_array(rhs, name, codename),
+                            name, codename);
+                    }
+
+                    // a local matrix needs all of the right hand side
+                    rhs = gather_partitioned_array(
+                        extract_partitioned_array(rhs, name, codename),
+                        name, codename);
+                }
+
+                // nothing is distributed, fall back to the local operation
+                primitive_arguments_type ops;
+                ops.reserve(2);
+                ops.emplace_back(std::move(lhs));
+                ops.emplace_back(std::move(rhs));
+
+                primitive op = create_primitive_component(
+                    hpx::find_here(), "dot", std::move(ops), "", codename);
+                return op.eval(hpx::launch::sync);
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            value_operand(operands[1], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> dist_dot_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
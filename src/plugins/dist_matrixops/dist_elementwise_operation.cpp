@@ -0,0 +1,239 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_elementwise_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+#define PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(op, description)                   \
+        hpx::util::make_tuple(#op "_d",                                        \
+            std::vector<std::string>{#op "_d(_1, _2)"},                        \
+            &create_##op##_d_operation,                                        \
+            &create_primitive<dist_elementwise_operation>,                     \
+            "a, b\n"                                                           \
+            "Args:\n"                                                          \
+            "\n"                                                               \
+            "    a (partitioned array or number) : the left hand side\n"       \
+            "    b (partitioned array or number) : the right hand side\n"      \
+            "\n"                                                               \
+            "Returns:\n"                                                       \
+            "\n"                                                               \
+            "The elementwise " description " of `a` and `b`, computed on "    \
+            "the localities owning the partitions. The result is partitioned " \
+            "like the partitioned operand(s). Local operands are broadcast "   \
+            "or split to match the partitions.")                               \
+    /**/
+
+    std::vector<match_pattern_type> const
+        dist_elementwise_operation::match_data =
+    {
+        PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(add, "sum"),
+        PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(sub, "difference"),
+        PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(mul, "product"),
+        PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(div, "quotient")
+    };
+
+#undef PHYLANX_DIST_ELEMENTWISE_MATCH_DATA
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string extract_dist_elementwise_name(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                std::string::size_type p = name.find_first_of("$");
+                if (p != std::string::npos)
+                {
+                    return name.substr(0, p);
+                }
+            }
+
+            return name_parts.primitive;
+        }
+
+        // Return the operand to use for the partition 'part' of the
+        // partitioned array 'arr' in place of the local value 'val'
+        primitive_argument_type local_partition_operand(
+            primitive_argument_type const& val, partitioned_array const& arr,
+            array_partition const& part, std::string const& name,
+            std::string const& codename)
+        {
+            std::size_t dims =
+                extract_numeric_value_dimension(val, name, codename);
+            if (dims == 0 || (dims == 1 && arr.dimensions == 2))
+            {
+                // scalars and (row) vectors are broadcast
+                return val;
+            }
+
+            std::array<std::size_t, 2> sizes =
+                extract_numeric_value_dimensions(val, name, codename);
+            if (dims != arr.dimensions ||
+                (dims == 1 && sizes[1] != arr.size) ||
+                (dims == 2 &&
+                    (sizes[0] != arr.size || sizes[1] != arr.columns)))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_elementwise_operation::eval",
+                    util::generate_error_message(
+                        "the local operand has a shape incompatible with "
+                        "the partitioned operand",
+                        name, codename));
+            }
+
+            return extract_partition_rows(
+                val, part.begin, part.size, name, codename);
+        }
+    }
+
+    dist_elementwise_operation::dist_elementwise_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+        // add_d -> __add, etc.
+        std::string func_name = detail::extract_dist_elementwise_name(name_);
+        operation_ = "__" + func_name.substr(0, func_name.size() - 2);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_elementwise_operation::elementwise(
+        primitive_argument_type&& lhs, primitive_argument_type&& rhs) const
+    {
+        bool lhs_partitioned = is_partitioned_array(lhs);
+        bool rhs_partitioned = is_partitioned_array(rhs);
+
+        if (!lhs_partitioned && !rhs_partitioned)
+        {
+            // nothing is distributed, fall back to the local operation
+            primitive_arguments_type ops;
+            ops.reserve(2);
+            ops.emplace_back(std::move(lhs));
+            ops.emplace_back(std::move(rhs));
+
+            primitive op = create_primitive_component(
+                hpx::find_here(), operation_, std::move(ops), "", codename_);
+            return op.eval(hpx::launch::sync);
+        }
+
+        partitioned_array arr = extract_partitioned_array(
+            lhs_partitioned ? lhs : rhs, name_, codename_);
+
+        partitioned_array other;
+        if (lhs_partitioned && rhs_partitioned)
+        {
+            other = extract_partitioned_array(rhs, name_, codename_);
+            if (!same_layout(arr, other))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_elementwise_operation::elementwise",
+                    generate_error_message(
+                        "the partitioned operands must have the same shape "
+                        "and must be split into the same partitions"));
+            }
+        }
+
+        std::vector<hpx::future<primitive>> tiles;
+        tiles.reserve(arr.partitions.size());
+        for (std::size_t i = 0; i != arr.partitions.size(); ++i)
+        {
+            auto const& part = arr.partitions[i];
+
+            primitive_arguments_type ops;
+            ops.reserve(2);
+            if (lhs_partitioned && rhs_partitioned)
+            {
+                ops.emplace_back(part.tile);
+                ops.emplace_back(other.partitions[i].tile);
+            }
+            else if (lhs_partitioned)
+            {
+                ops.emplace_back(part.tile);
+                ops.emplace_back(detail::local_partition_operand(
+                    rhs, arr, part, name_, codename_));
+            }
+            else
+            {
+                ops.emplace_back(detail::local_partition_operand(
+                    lhs, arr, part, name_, codename_));
+                ops.emplace_back(part.tile);
+            }
+
+            tiles.push_back(create_partition_tile(
+                part, operation_, std::move(ops), codename_));
+        }
+
+        for (std::size_t i = 0; i != tiles.size(); ++i)
+        {
+            arr.partitions[i].tile = tiles[i].get();
+        }
+        return make_partitioned_array(std::move(arr));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_elementwise_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::eval",
+                generate_error_message(
+                    "the distributed elementwise operations require exactly "
+                    "two operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::eval",
+                generate_error_message(
+                    "the distributed elementwise operations require that "
+                    "the arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& lhs,
+                primitive_argument_type&& rhs)
+            -> primitive_argument_type
+            {
+                return this_->elementwise(std::move(lhs), std::move(rhs));
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            value_operand(operands[1], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> dist_elementwise_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
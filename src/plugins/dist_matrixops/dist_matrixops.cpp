@@ -0,0 +1,46 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_matrixops.hpp>
+#include <phylanx/plugins/plugin_factory.hpp>
+
+#include <string>
+
+PHYLANX_REGISTER_PLUGIN_MODULE();
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(all_reduce_plugin,
+    phylanx::execution_tree::primitives::collective_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(broadcast_plugin,
+    phylanx::execution_tree::primitives::collective_operation::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(gather_plugin,
+    phylanx::execution_tree::primitives::collective_operation::match_data[2]);
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(partition_plugin,
+    phylanx::execution_tree::primitives::partition_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(unpartition_plugin,
+    phylanx::execution_tree::primitives::partition_operation::match_data[1]);
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(add_d_plugin,
+    phylanx::execution_tree::primitives::dist_elementwise_operation::
+        match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(sub_d_plugin,
+    phylanx::execution_tree::primitives::dist_elementwise_operation::
+        match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(mul_d_plugin,
+    phylanx::execution_tree::primitives::dist_elementwise_operation::
+        match_data[2]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(div_d_plugin,
+    phylanx::execution_tree::primitives::dist_elementwise_operation::
+        match_data[3]);
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(constant_d_plugin,
+    phylanx::execution_tree::primitives::dist_constant_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dot_d_plugin,
+    phylanx::execution_tree::primitives::dist_dot_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(sum_d_plugin,
+    phylanx::execution_tree::primitives::dist_sum_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(transpose_d_plugin,
+    phylanx::execution_tree::primitives::dist_transpose_operation::match_data);
@@ -0,0 +1,120 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_sum_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_sum_operation::match_data =
+    {
+        hpx::util::make_tuple("sum_d",
+            std::vector<std::string>{"sum_d(_1)"},
+            &create_dist_sum_operation, &create_primitive<dist_sum_operation>,
+            "a\n"
+            "Args:\n"
+            "\n"
+            "    a (partitioned array or array) : the values to add up\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The sum of all elements of `a`. The partial sums of the "
+            "partitions are computed on the localities owning them.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_sum_operation::dist_sum_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_sum_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_sum_operation::eval",
+                generate_error_message(
+                    "the sum_d primitive requires exactly one operand"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_sum_operation::eval",
+                generate_error_message(
+                    "the sum_d primitive requires that the argument given "
+                    "by the operands array is valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& arg)
+            -> primitive_argument_type
+            {
+                std::string const& codename = this_->codename_;
+
+                if (!is_partitioned_array(arg))
+                {
+                    // nothing is distributed, fall back to the local operation
+                    primitive op = create_primitive_component(
+                        hpx::find_here(), "sum", std::move(arg), "", codename);
+                    return op.eval(hpx::launch::sync);
+                }
+
+                partitioned_array arr = extract_partitioned_array(
+                    arg, this_->name_, codename);
+
+                std::vector<hpx::future<primitive_argument_type>> partials;
+                partials.reserve(arr.partitions.size());
+                for (auto const& part : arr.partitions)
+                {
+                    primitive_arguments_type ops;
+                    ops.emplace_back(part.tile);
+
+                    partials.push_back(evaluate_on_partition(
+                        part, "sum", std::move(ops), codename));
+                }
+
+                primitive_arguments_type results;
+                results.reserve(partials.size());
+                for (auto& f : partials)
+                {
+                    results.push_back(f.get());
+                }
+                return add_partial_results(std::move(results), codename);
+            }),
+            value_operand(operands[0], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> dist_sum_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
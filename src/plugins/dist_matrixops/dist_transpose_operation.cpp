@@ -0,0 +1,186 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_transpose_operation::match_data =
+    {
+        hpx::util::make_tuple("transpose_d",
+            std::vector<std::string>{"transpose_d(_1)"},
+            &create_dist_transpose_operation,
+            &create_primitive<dist_transpose_operation>,
+            "a\n"
+            "Args:\n"
+            "\n"
+            "    a (partitioned array or array) : the array to transpose\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "The transpose of `a`. For a partitioned matrix the result is "
+            "again partitioned by rows, each partition is assembled on the "
+            "locality owning the corresponding partition of `a`, which "
+            "receives only the column blocks it needs.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_transpose_operation::dist_transpose_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        primitive_argument_type make_index_range(
+            std::size_t begin, std::size_t end)
+        {
+            primitive_arguments_type indices;
+            indices.reserve(2);
+            indices.emplace_back(std::int64_t(begin));
+            indices.emplace_back(std::int64_t(end));
+            return primitive_argument_type{std::move(indices)};
+        }
+
+        primitive_argument_type transpose_partitioned(partitioned_array&& arr,
+            std::string const& codename)
+        {
+            // row block j of the result is made from column block j of all
+            // partitions of the operand
+            std::size_t num_partitions = arr.partitions.size();
+            if (num_partitions > arr.columns)
+            {
+                num_partitions = arr.columns;
+            }
+
+            std::vector<hpx::future<primitive>> tiles;
+            tiles.reserve(num_partitions);
+
+            partitioned_array result{2, arr.columns, arr.size, {}};
+            result.partitions.reserve(num_partitions);
+
+            for (std::size_t j = 0; j != num_partitions; ++j)
+            {
+                std::size_t begin = j * arr.columns / num_partitions;
+                std::size_t end = (j + 1) * arr.columns / num_partitions;
+
+                // the column blocks are cut on the localities owning the
+                // partitions and sent directly to the target locality
+                primitive_arguments_type blocks;
+                blocks.reserve(arr.partitions.size());
+                for (auto const& part : arr.partitions)
+                {
+                    primitive_arguments_type ops;
+                    ops.reserve(3);
+                    ops.emplace_back(part.tile);
+                    ops.emplace_back(make_index_range(0, part.size));
+                    ops.emplace_back(make_index_range(begin, end));
+
+                    blocks.emplace_back(create_primitive_component(
+                        partition_locality(part), "slice", std::move(ops), "",
+                        codename));
+                }
+
+                array_partition const& target = arr.partitions[j];
+                tiles.push_back(create_partition_tile(
+                    target, "vstack", std::move(blocks), codename).then(
+                        [target, codename](hpx::future<primitive>&& f)
+                        {
+                            primitive_arguments_type ops;
+                            ops.emplace_back(f.get());
+                            return create_partition_tile(target, "transpose",
+                                std::move(ops), codename).get();
+                        }));
+
+                result.partitions.push_back(array_partition{
+                    primitive{}, begin, end - begin, target.locality});
+            }
+
+            for (std::size_t j = 0; j != tiles.size(); ++j)
+            {
+                result.partitions[j].tile = tiles[j].get();
+            }
+            return make_partitioned_array(std::move(result));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_transpose_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_transpose_operation::eval",
+                generate_error_message(
+                    "the transpose_d primitive requires exactly one operand"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_transpose_operation::eval",
+                generate_error_message(
+                    "the transpose_d primitive requires that the argument "
+                    "given by the operands array is valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& arg)
+            -> primitive_argument_type
+            {
+                std::string const& codename = this_->codename_;
+
+                if (!is_partitioned_array(arg))
+                {
+                    // nothing is distributed, fall back to the local operation
+                    primitive op = create_primitive_component(hpx::find_here(),
+                        "transpose", std::move(arg), "", codename);
+                    return op.eval(hpx::launch::sync);
+                }
+
+                partitioned_array arr = extract_partitioned_array(
+                    arg, this_->name_, codename);
+                if (arr.dimensions == 1)
+                {
+                    return std::move(arg);      // no-op for vectors
+                }
+
+                return detail::transpose_partitioned(std::move(arr), codename);
+            }),
+            value_operand(operands[0], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> dist_transpose_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
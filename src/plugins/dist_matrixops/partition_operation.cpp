@@ -0,0 +1,227 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/variable.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/partition_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const partition_operation::match_data =
+    {
+        hpx::util::make_tuple("partition",
+            std::vector<std::string>{"partition(_1, _2)", "partition(_1)"},
+            &create_partition_operation,
+            &create_primitive<partition_operation>,
+            "a, n\n"
+            "Args:\n"
+            "\n"
+            "    a (vector or matrix) : the array to distribute\n"
+            "    n (optional, int) : the number of partitions, defaults to "
+            "the number of localities\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "A partitioned array holding `a` split into `n` blocks of rows "
+            "(elements for vectors) which are placed on the localities in a "
+            "round robin fashion."),
+
+        hpx::util::make_tuple("unpartition",
+            std::vector<std::string>{"unpartition(_1)"},
+            &create_unpartition_operation,
+            &create_primitive<partition_operation>,
+            "a\n"
+            "Args:\n"
+            "\n"
+            "    a (partitioned array) : the array to collect\n"
+            "\n"
+            "Returns:\n"
+            "\n"
+            "A local vector or matrix holding all partitions of `a`. Values "
+            "which are not partitioned are returned unchanged.")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string extract_partition_function_name(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                std::string::size_type p = name.find_first_of("$");
+                if (p != std::string::npos)
+                {
+                    return name.substr(0, p);
+                }
+            }
+
+            return name_parts.primitive;
+        }
+    }
+
+    partition_operation::partition_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , unpartition_(
+            detail::extract_partition_function_name(name_) == "unpartition")
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type partition_operation::partition(
+        primitive_argument_type&& arg, std::size_t num_partitions) const
+    {
+        std::size_t dims =
+            extract_numeric_value_dimension(arg, name_, codename_);
+        if (dims == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partition_operation::partition",
+                generate_error_message(
+                    "the partition primitive requires a vector or a matrix"));
+        }
+
+        std::array<std::size_t, 2> sizes =
+            extract_numeric_value_dimensions(arg, name_, codename_);
+
+        partitioned_array result;
+        result.dimensions = dims;
+        result.size = dims == 1 ? sizes[1] : sizes[0];
+        result.columns = dims == 1 ? 0 : sizes[1];
+
+        if (result.size == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partition_operation::partition",
+                generate_error_message(
+                    "the partition primitive can't distribute an empty "
+                    "array"));
+        }
+
+        result.partitions = make_partition_layout(result.size, num_partitions);
+        for (auto& part : result.partitions)
+        {
+            // the tiles are anonymous, see create_partition_tile
+            part.tile = create_variable(partition_locality(part),
+                extract_partition_rows(
+                    arg, part.begin, part.size, name_, codename_),
+                "", codename_);
+        }
+
+        return make_partitioned_array(std::move(result));
+    }
+
+    primitive_argument_type partition_operation::unpartition(
+        primitive_argument_type&& arg) const
+    {
+        if (!is_partitioned_array(arg))
+        {
+            return std::move(arg);
+        }
+
+        return gather_partitioned_array(
+            extract_partitioned_array(arg, name_, codename_), name_,
+            codename_);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> partition_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args) const
+    {
+        if (operands.empty() || operands.size() > (unpartition_ ? 1 : 2))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partition_operation::eval",
+                generate_error_message(unpartition_ ?
+                    "the unpartition primitive requires exactly one operand" :
+                    "the partition primitive requires one or two operands"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partition_operation::eval",
+                    generate_error_message(
+                        "the partition primitive requires that the "
+                        "arguments given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        if (unpartition_)
+        {
+            return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_argument_type&& arg)
+                -> primitive_argument_type
+                {
+                    return this_->unpartition(std::move(arg));
+                }),
+                value_operand(operands[0], args, name_, codename_));
+        }
+
+        if (operands.size() == 1)
+        {
+            return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_argument_type&& arg)
+                -> primitive_argument_type
+                {
+                    return this_->partition(std::move(arg), 0);
+                }),
+                value_operand(operands[0], args, name_, codename_));
+        }
+
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_argument_type&& arg,
+                std::int64_t num_partitions)
+            -> primitive_argument_type
+            {
+                if (num_partitions <= 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "partition_operation::eval",
+                        this_->generate_error_message(
+                            "the number of partitions must be positive"));
+                }
+                return this_->partition(
+                    std::move(arg), std::size_t(num_partitions));
+            }),
+            value_operand(operands[0], args, name_, codename_),
+            scalar_integer_operand_strict(
+                operands[1], args, name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> partition_operation::eval(
+        primitive_arguments_type const& args, eval_mode) const
+    {
+        if (this->no_operands())
+        {
+            return eval(args, noargs);
+        }
+        return eval(this->operands(), args);
+    }
+}}}
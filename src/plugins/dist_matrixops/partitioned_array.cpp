@@ -0,0 +1,351 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/primitives/slice.hpp>
+#include <phylanx/execution_tree/primitives/variable.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/plugins/dist_matrixops/partitioned_array.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        // The primitives created below are anonymous as they are created
+        // on each evaluation of the distributed operations, registering
+        // their names would cause clashes.
+        primitive create_partition_tile_here(std::string const& type,
+            primitive_arguments_type const& operands,
+            std::string const& codename)
+        {
+            primitive_arguments_type ops = operands;
+            primitive op = create_primitive_component(
+                hpx::find_here(), type, std::move(ops), "", codename);
+
+            return create_variable(hpx::find_here(),
+                extract_copy_value(op.eval(hpx::launch::sync), "", codename),
+                "", codename);
+        }
+
+        primitive_argument_type evaluate_on_partition_here(
+            std::string const& type, primitive_arguments_type const& operands,
+            std::string const& codename)
+        {
+            primitive_arguments_type ops = operands;
+            primitive op = create_primitive_component(
+                hpx::find_here(), type, std::move(ops), "", codename);
+
+            return extract_copy_value(
+                op.eval(hpx::launch::sync), "", codename);
+        }
+    }
+}}}
+
+HPX_PLAIN_ACTION(
+    phylanx::execution_tree::primitives::detail::create_partition_tile_here,
+    create_partition_tile_action);
+HPX_PLAIN_ACTION(
+    phylanx::execution_tree::primitives::detail::evaluate_on_partition_here,
+    evaluate_on_partition_action);
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string const partitioned_array_tag = "__partitioned";
+    }
+
+    bool is_partitioned_array(primitive_argument_type const& val)
+    {
+        return is_partitioned_operand(val);
+    }
+
+    partitioned_array extract_partitioned_array(
+        primitive_argument_type const& val, std::string const& name,
+        std::string const& codename)
+    {
+        if (!is_partitioned_array(val))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "extract_partitioned_array",
+                util::generate_error_message(
+                    "the given value does not represent a partitioned array",
+                    name, codename));
+        }
+
+        // list("__partitioned", dimensions, size, columns,
+        //      list(tile, begin, size, locality), ...)
+        primitive_arguments_type elements = util::get<7>(val).copy();
+        if (elements.size() < 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "extract_partitioned_array",
+                util::generate_error_message(
+                    "a partitioned array must have at least one partition",
+                    name, codename));
+        }
+
+        partitioned_array result;
+        result.dimensions = std::size_t(
+            extract_scalar_integer_value(elements[1], name, codename));
+        result.size = std::size_t(
+            extract_scalar_integer_value(elements[2], name, codename));
+        result.columns = std::size_t(
+            extract_scalar_integer_value(elements[3], name, codename));
+
+        result.partitions.reserve(elements.size() - 4);
+        for (std::size_t i = 4; i != elements.size(); ++i)
+        {
+            primitive_arguments_type part =
+                extract_list_value_strict(elements[i], name, codename).copy();
+
+            primitive const* tile =
+                part.size() == 4 ? util::get_if<primitive>(&part[0]) : nullptr;
+            if (tile == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::"
+                        "extract_partitioned_array",
+                    util::generate_error_message(
+                        "malformed partition description", name, codename));
+            }
+
+            result.partitions.push_back(array_partition{*tile,
+                std::size_t(
+                    extract_scalar_integer_value(part[1], name, codename)),
+                std::size_t(
+                    extract_scalar_integer_value(part[2], name, codename)),
+                std::uint32_t(
+                    extract_scalar_integer_value(part[3], name, codename))});
+        }
+
+        return result;
+    }
+
+    primitive_argument_type make_partitioned_array(partitioned_array&& arr)
+    {
+        primitive_arguments_type result;
+        result.reserve(arr.partitions.size() + 4);
+
+        result.emplace_back(detail::partitioned_array_tag);
+        result.emplace_back(std::int64_t(arr.dimensions));
+        result.emplace_back(std::int64_t(arr.size));
+        result.emplace_back(std::int64_t(arr.columns));
+
+        for (auto&& part : arr.partitions)
+        {
+            primitive_arguments_type desc;
+            desc.reserve(4);
+            desc.emplace_back(std::move(part.tile));
+            desc.emplace_back(std::int64_t(part.begin));
+            desc.emplace_back(std::int64_t(part.size));
+            desc.emplace_back(std::int64_t(part.locality));
+
+            result.emplace_back(std::move(desc));
+        }
+
+        return primitive_argument_type{std::move(result)};
+    }
+
+    bool same_layout(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        if (lhs.dimensions != rhs.dimensions || lhs.size != rhs.size ||
+            lhs.columns != rhs.columns ||
+            lhs.partitions.size() != rhs.partitions.size())
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i != lhs.partitions.size(); ++i)
+        {
+            if (lhs.partitions[i].begin != rhs.partitions[i].begin ||
+                lhs.partitions[i].size != rhs.partitions[i].size)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    hpx::id_type partition_locality(array_partition const& part)
+    {
+        return hpx::naming::get_id_from_locality_id(part.locality);
+    }
+
+    std::vector<array_partition> make_partition_layout(
+        std::size_t size, std::size_t num_partitions)
+    {
+        std::vector<hpx::id_type> localities = hpx::find_all_localities();
+        if (num_partitions == 0)
+        {
+            num_partitions = localities.size();
+        }
+        if (num_partitions > size)
+        {
+            num_partitions = size;
+        }
+
+        std::vector<array_partition> result;
+        result.reserve(num_partitions);
+        for (std::size_t i = 0; i != num_partitions; ++i)
+        {
+            std::size_t begin = i * size / num_partitions;
+            std::size_t end = (i + 1) * size / num_partitions;
+
+            result.push_back(array_partition{primitive{}, begin, end - begin,
+                hpx::naming::get_locality_id_from_id(
+                    localities[i % localities.size()])});
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive> create_partition_tile(array_partition const& part,
+        std::string const& type, primitive_arguments_type&& operands,
+        std::string const& codename)
+    {
+        return hpx::async(create_partition_tile_action{},
+            partition_locality(part), type, std::move(operands), codename);
+    }
+
+    hpx::future<primitive_argument_type> evaluate_on_partition(
+        array_partition const& part, std::string const& type,
+        primitive_arguments_type&& operands, std::string const& codename)
+    {
+        return hpx::async(evaluate_on_partition_action{},
+            partition_locality(part), type, std::move(operands), codename);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type extract_partition_rows(
+        primitive_argument_type const& val, std::size_t begin,
+        std::size_t size, std::string const& name,
+        std::string const& codename)
+    {
+        primitive_arguments_type indices;
+        indices.reserve(2);
+        indices.emplace_back(std::int64_t(begin));
+        indices.emplace_back(std::int64_t(begin + size));
+
+        return extract_copy_value(
+            slice(val, primitive_argument_type{std::move(indices)}, name,
+                codename),
+            name, codename);
+    }
+
+    primitive_argument_type add_partial_results(
+        primitive_arguments_type&& partials, std::string const& codename)
+    {
+        if (partials.size() == 1)
+        {
+            return std::move(partials[0]);
+        }
+
+        primitive op = create_primitive_component(
+            hpx::find_here(), "__add", std::move(partials), "", codename);
+        return op.eval(hpx::launch::sync);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T>
+        primitive_argument_type gather_partitions(
+            partitioned_array const& arr, primitive_arguments_type&& values,
+            std::string const& name, std::string const& codename)
+        {
+            if (arr.dimensions == 1)
+            {
+                blaze::DynamicVector<T> result(arr.size);
+                for (std::size_t i = 0; i != values.size(); ++i)
+                {
+                    auto const& part = arr.partitions[i];
+                    auto data = extract_node_data<T>(
+                        std::move(values[i]), name, codename);
+                    blaze::subvector(result, part.begin, part.size) =
+                        data.vector();
+                }
+                return primitive_argument_type{std::move(result)};
+            }
+
+            blaze::DynamicMatrix<T> result(arr.size, arr.columns);
+            for (std::size_t i = 0; i != values.size(); ++i)
+            {
+                auto const& part = arr.partitions[i];
+                auto data =
+                    extract_node_data<T>(std::move(values[i]), name, codename);
+                blaze::submatrix(result, part.begin, 0, part.size,
+                    arr.columns) = data.matrix();
+            }
+            return primitive_argument_type{std::move(result)};
+        }
+    }
+
+    primitive_argument_type gather_partitioned_array(
+        partitioned_array const& arr, std::string const& name,
+        std::string const& codename)
+    {
+        std::vector<hpx::future<primitive_argument_type>> futures;
+        futures.reserve(arr.partitions.size());
+        for (auto const& part : arr.partitions)
+        {
+            futures.push_back(part.tile.eval());
+        }
+
+        primitive_arguments_type values;
+        values.reserve(futures.size());
+        for (auto& f : futures)
+        {
+            values.push_back(f.get());
+        }
+
+        switch (extract_common_type(values))
+        {
+        case node_data_type_bool:
+            return detail::gather_partitions<std::uint8_t>(
+                arr, std::move(values), name, codename);
+
+        case node_data_type_int64:
+            return detail::gather_partitions<std::int64_t>(
+                arr, std::move(values), name, codename);
+
+        case node_data_type_double:
+            return detail::gather_partitions<double>(
+                arr, std::move(values), name, codename);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::execution_tree::primitives::gather_partitioned_array",
+            util::generate_error_message(
+                "the partitions hold values of an unsupported type",
+                name, codename));
+    }
+}}}
@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/count_nonzero_operation.hpp>
+#include <phylanx/util/bit_mask.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -91,7 +92,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         template <typename T>
         std::int64_t count_nonzero1d(ir::node_data<T>&& arg)
         {
-            return blaze::nonZeros(arg.vector());
+            auto v = arg.vector();
+            return std::int64_t(util::mask_count(v.size(),
+                [&](std::size_t i)
+                {
+                    return v[i] != 0;
+                }));
         }
     }
 
@@ -127,7 +133,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         template <typename T>
         std::int64_t count_nonzero2d(ir::node_data<T>&& arg)
         {
-            return blaze::nonZeros(arg.matrix());
+            auto m = arg.matrix();
+            std::size_t result = 0;
+            for (std::size_t row = 0; row != m.rows(); ++row)
+            {
+                result += util::mask_count(m.columns(),
+                    [&](std::size_t column)
+                    {
+                        return m(row, column) != 0;
+                    });
+            }
+            return std::int64_t(result);
         }
     }
 
@@ -295,9 +295,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         auto this_ = this->shared_from_this();
         return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-            [this_ = std::move(this_)](operand_type&& op1, operand_type&& op2)
+            [this_ = std::move(this_)](primitive_argument_type&& lhs,
+                primitive_argument_type&& rhs)
             ->  primitive_argument_type
             {
+                if (is_partitioned_operand(lhs) || is_partitioned_operand(rhs))
+                {
+                    return partitioned_operation("dot_d", std::move(lhs),
+                        std::move(rhs), this_->codename_);
+                }
+
+                operand_type op1 = extract_numeric_value(
+                    std::move(lhs), this_->name_, this_->codename_);
+                operand_type op2 = extract_numeric_value(
+                    std::move(rhs), this_->name_, this_->codename_);
+
                 std::size_t dims = op1.num_dimensions();
                 switch (dims)
                 {
@@ -319,8 +331,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             this_->name_, this_->codename_));
                 }
             }),
-            numeric_operand(operands[0], args, name_, codename_),
-            numeric_operand(operands[1], args, name_, codename_));
+            value_operand(operands[0], args, name_, codename_),
+            value_operand(operands[1], args, name_, codename_));
     }
 
     // implement 'dot' for all possible combinations of lhs and rhs
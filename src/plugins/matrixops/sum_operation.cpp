@@ -199,6 +199,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 [this_ = std::move(this_)](primitive_arguments_type&& args)
                     -> primitive_argument_type
                 {
+                    if (is_partitioned_operand(args[0]))
+                    {
+                        if (args.size() != 1)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "sum_operation::eval",
+                                util::generate_error_message(
+                                    "the sum of a partitioned array can be "
+                                    "computed over all elements only",
+                                    this_->name_, this_->codename_));
+                        }
+                        return partitioned_operation(
+                            "sum_d", std::move(args), this_->codename_);
+                    }
+
                     // Extract axis and keep_dims
                     // Presence of axis changes behavior for >2d cases
                     hpx::util::optional<std::int64_t> axis;
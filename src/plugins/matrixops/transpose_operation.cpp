@@ -74,9 +74,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         auto this_ = this->shared_from_this();
         return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-            [this_ = std::move(this_), name, codename](operands_type&& ops)
+            [this_ = std::move(this_), name, codename](
+                primitive_argument_type&& arg)
             -> primitive_argument_type
             {
+                if (is_partitioned_operand(arg))
+                {
+                    primitive_arguments_type vals;
+                    vals.emplace_back(std::move(arg));
+                    return partitioned_operation(
+                        "transpose_d", std::move(vals), codename);
+                }
+
+                operands_type ops;
+                ops.emplace_back(
+                    extract_numeric_value(std::move(arg), name, codename));
+
                 std::size_t dims = ops[0].num_dimensions();
                 switch (dims)
                 {
@@ -98,9 +111,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             name, codename));
                 }
             }),
-            detail::map_operands(
-                operands, functional::numeric_operand{}, args,
-                name, codename));
+            value_operand(operands[0], args, name, codename));
     }
 
     primitive_argument_type transpose_operation::transpose0d1d(
@@ -0,0 +1,310 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/util/eval_trace.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        struct eval_trace_buffer
+        {
+            eval_trace_buffer()
+              : enabled_(false)
+              , writers_(0)
+              , next_(0)
+            {}
+
+            std::atomic<bool> enabled_;
+
+            // number of threads currently storing an event
+            std::atomic<std::size_t> writers_;
+
+            // monotonically increasing index of the next event to write, the
+            // slot used is next_ % events_.size()
+            std::atomic<std::uint64_t> next_;
+            std::vector<eval_trace_event> events_;
+
+            mutex_type mtx_;
+            std::set<std::string> names_;
+        };
+
+        eval_trace_buffer& get_eval_trace_buffer()
+        {
+            static eval_trace_buffer buffer;
+            return buffer;
+        }
+
+        // Stop recording and wait for the threads currently storing an event
+        // to finish, returns whether recording was enabled. This allows to
+        // access the events without racing with the writers. Must be called
+        // while holding mtx_.
+        bool suspend_recording(eval_trace_buffer& buffer)
+        {
+            bool was_enabled = buffer.enabled_.exchange(false);
+            while (buffer.writers_.load() != 0)
+            {
+                // writers never block while storing an event
+            }
+            return was_enabled;
+        }
+
+        std::size_t default_eval_trace_buffer_size()
+        {
+            return std::stoul(hpx::get_config_entry(
+                "phylanx.eval_trace_buffer_size", "65536"));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void write_json_string(std::ostream& os, std::string const& s)
+        {
+            os << '"';
+            for (char c : s)
+            {
+                switch (c)
+                {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n"; break;
+                case '\t': os << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        os << "\\u" << std::hex << std::setw(4)
+                           << std::setfill('0') << int(c) << std::dec;
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                    break;
+                }
+            }
+            os << '"';
+        }
+
+        void write_json_shape(
+            std::ostream& os, eval_trace_event::shape_type const& shape)
+        {
+            if (shape[0] < 0)
+            {
+                os << "null";
+                return;
+            }
+
+            os << '[';
+            for (std::int64_t i = 0; i != shape[0]; ++i)
+            {
+                if (i != 0)
+                {
+                    os << ',';
+                }
+                os << shape[i + 1];
+            }
+            os << ']';
+        }
+
+        std::string trace_display_name(char const* name)
+        {
+            execution_tree::compiler::primitive_name_parts parts;
+            if (!execution_tree::compiler::parse_primitive_name(name, parts))
+            {
+                return name;
+            }
+            return execution_tree::compiler::compose_primitive_display_name(
+                parts);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool enable_eval_trace(bool enable, std::size_t buffer_size)
+    {
+        auto& buffer = detail::get_eval_trace_buffer();
+
+        std::lock_guard<detail::mutex_type> l(buffer.mtx_);
+
+        bool was_enabled = detail::suspend_recording(buffer);
+        if (enable)
+        {
+            if (buffer_size == 0 && buffer.events_.empty())
+            {
+                buffer_size = detail::default_eval_trace_buffer_size();
+            }
+
+            if (buffer_size != 0 && buffer_size != buffer.events_.size())
+            {
+                // resizing invalidates all recorded events
+                buffer.events_.resize(buffer_size);
+                buffer.next_ = 0;
+            }
+
+            if (buffer.events_.empty())
+            {
+                buffer.enabled_ = was_enabled;
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::util::enable_eval_trace",
+                    "the size of the buffer for recording primitive "
+                        "evaluations must not be zero");
+            }
+        }
+
+        buffer.enabled_ = enable;
+        return was_enabled;
+    }
+
+    bool eval_trace_enabled()
+    {
+        return detail::get_eval_trace_buffer().enabled_.load(
+            std::memory_order_relaxed);
+    }
+
+    char const* eval_trace_intern(std::string const& name)
+    {
+        auto& buffer = detail::get_eval_trace_buffer();
+
+        std::lock_guard<detail::mutex_type> l(buffer.mtx_);
+        return buffer.names_.insert(name).first->c_str();
+    }
+
+    void record_eval_trace(eval_trace_event const& event)
+    {
+        auto& buffer = detail::get_eval_trace_buffer();
+
+        // announce the write before checking whether recording is (still)
+        // enabled, suspend_recording waits for all announced writers
+        ++buffer.writers_;
+        if (buffer.enabled_.load())
+        {
+            std::uint64_t idx = buffer.next_++;
+            buffer.events_[idx % buffer.events_.size()] = event;
+        }
+        --buffer.writers_;
+    }
+
+    std::vector<eval_trace_event> retrieve_eval_trace(bool reset)
+    {
+        auto& buffer = detail::get_eval_trace_buffer();
+
+        std::lock_guard<detail::mutex_type> l(buffer.mtx_);
+
+        // events recorded while retrieving are dropped
+        bool was_enabled = detail::suspend_recording(buffer);
+
+        std::vector<eval_trace_event> result;
+
+        std::uint64_t next = buffer.next_;
+        std::size_t size = buffer.events_.size();
+        if (next <= size)
+        {
+            result.assign(buffer.events_.begin(), buffer.events_.begin() + next);
+        }
+        else
+        {
+            // the buffer has wrapped around, the oldest event is stored in
+            // the slot written next
+            auto start = buffer.events_.begin() + (next % size);
+            result.reserve(size);
+            result.assign(start, buffer.events_.end());
+            result.insert(result.end(), buffer.events_.begin(), start);
+        }
+
+        if (reset)
+        {
+            buffer.next_ = 0;
+        }
+
+        buffer.enabled_ = was_enabled;
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void write_chrome_trace(
+        std::ostream& os, std::vector<eval_trace_event> const& events)
+    {
+        // timestamps are written in [us] relative to the earliest event
+        std::uint64_t start = (std::numeric_limits<std::uint64_t>::max)();
+        for (auto const& e : events)
+        {
+            start = (std::min)(start, e.begin_);
+        }
+
+        os << "{\"traceEvents\":[";
+
+        bool first = true;
+        for (auto const& e : events)
+        {
+            if (!first)
+            {
+                os << ',';
+            }
+            first = false;
+
+            os << "\n{\"name\":";
+            detail::write_json_string(os, detail::trace_display_name(e.name_));
+            os << ",\"cat\":\"primitive\",\"ph\":\"X\""
+               << std::fixed << std::setprecision(3)
+               << ",\"ts\":" << (e.begin_ - start) / 1000.
+               << ",\"dur\":" << (e.end_ - e.begin_) / 1000.
+               << ",\"pid\":" << e.locality_
+               << ",\"tid\":" << e.worker_thread_
+               << ",\"args\":{\"primitive\":";
+            detail::write_json_string(os, e.name_);
+
+            os << ",\"arguments\":[";
+            std::size_t num_shapes = e.num_args_;
+            if (num_shapes > eval_trace_event::max_args)
+            {
+                num_shapes = eval_trace_event::max_args;
+            }
+            for (std::size_t i = 0; i != num_shapes; ++i)
+            {
+                if (i != 0)
+                {
+                    os << ',';
+                }
+                detail::write_json_shape(os, e.arg_shapes_[i]);
+            }
+            os << "],\"num_arguments\":" << e.num_args_ << ",\"result\":";
+            detail::write_json_shape(os, e.result_shape_);
+            os << "}}";
+        }
+
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    void write_chrome_trace(std::string const& filename, bool reset)
+    {
+        std::ofstream os(filename);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::util::write_chrome_trace",
+                "couldn't open file: " + filename);
+        }
+
+        write_chrome_trace(os, retrieve_eval_trace(reset));
+    }
+}}
@@ -7,6 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
 #include <phylanx/util/performance_data.hpp>
 
 #include <hpx/include/agas.hpp>
@@ -14,23 +15,51 @@
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/include/runtime.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <map>
 #include <memory>
-#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace phylanx { namespace util
 {
+    namespace detail
+    {
+        // Find all primitives living on the given locality
+        std::map<std::string, hpx::id_type> find_primitives(
+            std::uint32_t locality_id)
+        {
+            auto entries =
+                hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*");
+
+            for (auto it = entries.begin(); it != entries.end(); /**/)
+            {
+                if (hpx::naming::get_locality_id_from_id(it->second) !=
+                    locality_id)
+                {
+                    it = entries.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            return entries;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     std::vector<std::string> enable_measurements(
-        std::map<std::string, hpx::id_type> const& primitive_instances)
+        std::map<std::string, hpx::id_type> const& primitive_instances,
+        bool size_histogram)
     {
         using phylanx::execution_tree::primitives::primitive_component;
 
@@ -51,16 +80,76 @@ namespace phylanx { namespace util
 
         for (auto& f : primitives)
         {
-            f.get()->enable_measurements();
+            f.get()->enable_measurements(size_histogram);
         }
 
         return result;
     }
 
-    std::vector<std::string> enable_measurements()
+    std::vector<std::string> enable_measurements(bool size_histogram)
     {
         return enable_measurements(
-            hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*"));
+            detail::find_primitives(hpx::get_locality_id()), size_histogram);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::map<std::string, std::vector<std::pair<std::int64_t, std::int64_t>>>
+    retrieve_size_histogram(
+        std::map<std::string, hpx::id_type> const& primitive_instances,
+        bool reset)
+    {
+        using phylanx::execution_tree::primitives::primitive_component;
+        using phylanx::execution_tree::primitives::primitive_component_base;
+
+        std::vector<hpx::future<std::shared_ptr<primitive_component>>> primitives;
+        primitives.reserve(primitive_instances.size());
+
+        for (auto const& entry : primitive_instances)
+        {
+            primitives.emplace_back(
+                hpx::get_ptr<primitive_component>(entry.second));
+        }
+
+        hpx::wait_all(primitives);
+
+        std::map<std::string, std::vector<std::pair<std::int64_t, std::int64_t>>>
+            result;
+
+        std::size_t const num_size_classes =
+            primitive_component_base::num_size_classes;
+
+        auto it = primitive_instances.begin();
+        for (auto& f : primitives)
+        {
+            auto p = f.get();
+
+            std::vector<std::pair<std::int64_t, std::int64_t>> histogram;
+            histogram.reserve(num_size_classes);
+
+            bool has_data = false;
+            for (std::size_t k = 0; k != num_size_classes; ++k)
+            {
+                std::int64_t count = p->get_size_class_eval_count(k, reset);
+                has_data = has_data || count != 0;
+                histogram.emplace_back(
+                    count, p->get_size_class_eval_duration(k, reset));
+            }
+
+            if (has_data)
+            {
+                result[it->first] = std::move(histogram);
+            }
+            ++it;
+        }
+
+        return result;
+    }
+
+    std::map<std::string, std::vector<std::pair<std::int64_t, std::int64_t>>>
+    retrieve_size_histogram(bool reset)
+    {
+        return retrieve_size_histogram(
+            detail::find_primitives(hpx::get_locality_id()), reset);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -148,12 +237,9 @@ namespace phylanx { namespace util
             }
         }
 
-        // collect range of tags for each primitive type
-        std::map<std::string, std::pair<std::int64_t, std::int64_t>> tag_ranges;
-
-        // Iterate and collect the result from the futures
-        constexpr std::int64_t maxval = (std::numeric_limits<std::int64_t>::max)();
-        constexpr std::int64_t minval = (std::numeric_limits<std::int64_t>::min)();
+        // The counters report the values of the instances of each primitive
+        // type sorted by their sequence numbers
+        std::map<std::string, std::vector<std::int64_t>> sequence_numbers;
 
         for (auto const& name : primitive_instances)
         {
@@ -161,18 +247,12 @@ namespace phylanx { namespace util
             auto const tags =
                 phylanx::execution_tree::compiler::parse_primitive_name(name);
 
-            auto it = tag_ranges.find(tags.primitive);
-            if (it == tag_ranges.end())
-            {
-                auto p = tag_ranges.insert(decltype(tag_ranges)::value_type(
-                    tags.primitive, std::make_pair(maxval, minval)));
-                it = p.first;
-            }
+            sequence_numbers[tags.primitive].push_back(tags.sequence_number);
+        }
 
-            it->second.first =
-                (std::min)(it->second.first, tags.sequence_number);
-            it->second.second =
-                (std::max)(it->second.second, tags.sequence_number);
+        for (auto& entry : sequence_numbers)
+        {
+            std::sort(entry.second.begin(), entry.second.end());
         }
 
         // Return value
@@ -189,17 +269,19 @@ namespace phylanx { namespace util
             std::vector<std::vector<std::int64_t>>& counter_values =
                 counter_values_pile[tags.primitive];
 
-            // extract offset for sequence number
-            auto const& r = tag_ranges[tags.primitive];
+            // extract index of this instance
+            auto const& seq = sequence_numbers[tags.primitive];
+            std::size_t index = std::distance(seq.begin(),
+                std::lower_bound(
+                    seq.begin(), seq.end(), tags.sequence_number));
 
             // Collect the performance counter values
             std::vector<std::int64_t> data(counter_name_last_parts.size());
             for (unsigned int i = 0; i < counter_values.size(); ++i)
             {
-                HPX_ASSERT(static_cast<std::size_t>(r.second - r.first) <
-                    counter_values[i].size());
+                HPX_ASSERT(index < counter_values[i].size());
 
-                data[i] = counter_values[i][tags.sequence_number - r.first];
+                data[i] = counter_values[i][index];
             }
 
             result.emplace(decltype(result)::value_type(name, data));
@@ -223,8 +305,9 @@ namespace phylanx { namespace util
     std::map<std::string, std::vector<std::int64_t>> retrieve_counter_data(
         hpx::naming::id_type const& locality_id)
     {
-        auto entries =
-            hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*");
+        // the counters report the values of the local primitives only
+        auto entries = detail::find_primitives(
+            hpx::naming::get_locality_id_from_id(locality_id));
 
         std::vector<std::string> primitive_instances;
         primitive_instances.reserve(entries.size());
@@ -236,4 +319,146 @@ namespace phylanx { namespace util
 
         return retrieve_counter_data(primitive_instances, locality_id);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        void accumulate_counter_values(std::vector<std::int64_t>& target,
+            std::vector<std::int64_t> const& values)
+        {
+            if (target.size() < values.size())
+            {
+                target.resize(values.size(), 0);
+            }
+            for (std::size_t i = 0; i != values.size(); ++i)
+            {
+                target[i] += values[i];
+            }
+        }
+
+        counter_data_summary summarize_counter_data(
+            std::vector<std::string> const& counter_name_last_parts,
+            std::vector<std::uint32_t> const& locality_ids,
+            std::vector<std::map<std::string, std::vector<std::int64_t>>>&&
+                data)
+        {
+            counter_data_summary result;
+            result.counter_names = counter_name_last_parts;
+
+            std::size_t const num_counters = counter_name_last_parts.size();
+            for (std::size_t i = 0; i != data.size(); ++i)
+            {
+                std::vector<std::int64_t>& locality_values =
+                    result.localities[locality_ids[i]];
+                locality_values.resize(num_counters, 0);
+
+                for (auto& entry : data[i])
+                {
+                    auto const tags = phylanx::execution_tree::compiler::
+                        parse_primitive_name(entry.first);
+
+                    accumulate_counter_values(locality_values, entry.second);
+                    accumulate_counter_values(
+                        result.primitives[tags.primitive], entry.second);
+
+                    result.instances.emplace(
+                        std::move(entry.first), std::move(entry.second));
+                }
+            }
+
+            // load imbalance: maximum over average of the per-locality values
+            result.load_imbalance.resize(num_counters, 1.0);
+            for (std::size_t i = 0; i != num_counters; ++i)
+            {
+                std::int64_t max_value = 0;
+                std::int64_t sum = 0;
+                for (auto const& entry : result.localities)
+                {
+                    max_value = (std::max)(max_value, entry.second[i]);
+                    sum += entry.second[i];
+                }
+
+                if (sum != 0)
+                {
+                    result.load_imbalance[i] = double(max_value) *
+                        double(result.localities.size()) / double(sum);
+                }
+            }
+
+            return result;
+        }
+    }
+
+    hpx::future<counter_data_summary> retrieve_all_counter_data(
+        std::vector<std::string> const& counter_name_last_parts)
+    {
+        if (counter_name_last_parts.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "retrieve_all_counter_data",
+                "counter_name_last_parts cannot be empty");
+        }
+
+        // group the primitive instances by the locality they live on
+        std::map<std::uint32_t, std::vector<std::string>> instances;
+        for (auto&& entry :
+            hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*"))
+        {
+            instances[hpx::naming::get_locality_id_from_id(entry.second)]
+                .push_back(std::move(entry.first));
+        }
+
+        // query all localities concurrently
+        std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+        std::vector<std::uint32_t> locality_ids;
+        locality_ids.reserve(localities.size());
+
+        std::vector<
+            hpx::future<std::map<std::string, std::vector<std::int64_t>>>>
+            data;
+        data.reserve(localities.size());
+
+        for (auto const& locality : localities)
+        {
+            std::uint32_t locality_id =
+                hpx::naming::get_locality_id_from_id(locality);
+            locality_ids.push_back(locality_id);
+
+            std::vector<std::string>& names = instances[locality_id];
+            if (names.empty())
+            {
+                data.push_back(hpx::make_ready_future(
+                    std::map<std::string, std::vector<std::int64_t>>{}));
+                continue;
+            }
+
+            data.push_back(hpx::async(
+                [names = std::move(names), counter_name_last_parts,
+                    locality]()
+                {
+                    return retrieve_counter_data(
+                        names, counter_name_last_parts, locality);
+                }));
+        }
+
+        return hpx::dataflow(hpx::util::unwrapping(
+            [counter_name_last_parts, locality_ids = std::move(locality_ids)](
+                std::vector<std::map<std::string, std::vector<std::int64_t>>>&&
+                    data)
+            {
+                return detail::summarize_counter_data(
+                    counter_name_last_parts, locality_ids, std::move(data));
+            }),
+            std::move(data));
+    }
+
+    hpx::future<counter_data_summary> retrieve_all_counter_data()
+    {
+        std::vector<std::string> const counter_names{
+            "count/eval", "time/eval", "eval_direct"
+        };
+
+        return retrieve_all_counter_data(counter_names);
+    }
 }}
@@ -5,11 +5,17 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/plugin_factory.hpp>
+#include <phylanx/util/eval_trace.hpp>
 
 #include <hpx/include/components.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
 #include <hpx/runtime/startup_function.hpp>
 #include <hpx/runtime/shutdown_function.hpp>
 
+#include <cstdint>
+#include <string>
+
 namespace phylanx
 {
     namespace performance_counters
@@ -30,10 +36,31 @@ namespace phylanx { namespace util
 
         // register performance counters for all discovered primitives
         performance_counters::startup_counters();
+
+        // record the timeline of all primitive evaluations, if requested
+        if (!hpx::get_config_entry("phylanx.eval_trace", "").empty())
+        {
+            enable_eval_trace();
+        }
     }
 
     void shutdown()
     {
+        // write the recorded timeline of primitive evaluations
+        std::string trace_file = hpx::get_config_entry("phylanx.eval_trace", "");
+        if (!trace_file.empty())
+        {
+            // every locality except the first writes to its own file
+            std::uint32_t locality_id = hpx::get_locality_id();
+            if (locality_id != 0)
+            {
+                trace_file += "." + std::to_string(locality_id);
+            }
+
+            enable_eval_trace(false);
+            write_chrome_trace(trace_file);
+        }
+
         // unload all plugin modules
         plugin_map.clear();
     }
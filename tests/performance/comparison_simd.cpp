@@ -0,0 +1,134 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the SIMD functors used by the comparison and logical primitives
+// with the scalar lambdas they replaced.
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/detail/comparison_simd.hpp>
+#include <phylanx/util/detail/logical_simd.hpp>
+#include <phylanx/util/detail/predicate_simd.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const size = 1000000;
+std::size_t const columns = 1000;
+int const repetitions = 20;
+
+// Run f repeatedly and return the best time in [ms]
+template <typename F>
+double measure(F && f)
+{
+    double best = 0.0;
+    for (int i = 0; i != repetitions; ++i)
+    {
+        std::uint64_t t = hpx::util::high_resolution_clock::now();
+        f();
+        t = hpx::util::high_resolution_clock::now() - t;
+
+        if (i == 0 || t / 1e6 < best)
+        {
+            best = t / 1e6;
+        }
+    }
+    return best;
+}
+
+void report(std::string const& name, double scalar, double simd)
+{
+    std::cout << name << ": scalar " << scalar << " ms, simd " << simd
+              << " ms, speedup " << (scalar / simd) << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    using namespace phylanx::util::detail;
+
+#if !defined(PHYLANX_HAVE_SIMD_PREDICATES)
+    std::cout << "note: Blaze vectorization is disabled, both variants use "
+                 "the scalar code path\n";
+#endif
+
+    blaze::DynamicVector<double> x = blaze::rand<blaze::DynamicVector<double>>(
+        size, -1.0, 1.0);
+    blaze::DynamicVector<double> y = blaze::rand<blaze::DynamicVector<double>>(
+        size, -1.0, 1.0);
+    blaze::DynamicVector<double> result(size);
+
+    // scalar broadcast, x > 0.5
+    report("greater (vector, scalar)",
+        measure([&]() {
+            result = blaze::map(x, [](double a) { return a > 0.5; });
+        }),
+        measure([&]() {
+            result = blaze::map(
+                x, predicatend0d_simd<greater_simd_op, double>(0.5));
+        }));
+
+    // elementwise, x <= y
+    report("less_equal (vector, vector)",
+        measure([&]() {
+            result = blaze::map(
+                x, y, [](double a, double b) { return a <= b; });
+        }),
+        measure([&]() {
+            result = blaze::map(x, y, predicatendnd_simd<less_equal_simd_op>{});
+        }));
+
+    // elementwise, x && y
+    report("and (vector, vector)",
+        measure([&]() {
+            result = blaze::map(x, y, [](bool a, bool b) { return a && b; });
+        }),
+        measure([&]() {
+            result = blaze::map(x, y, predicatendnd_simd<and_simd_op>{});
+        }));
+
+    // unary, !x
+    report("not (vector)",
+        measure([&]() {
+            result = blaze::map(x, [](double a) { return a == 0.0; });
+        }),
+        measure([&]() {
+            result = blaze::map(x, predicate_simd<not_simd_op>{});
+        }));
+
+    // row broadcast, m == v
+    blaze::DynamicMatrix<double> m =
+        blaze::rand<blaze::DynamicMatrix<double>>(
+            size / columns, columns, 0, 4);
+    blaze::DynamicVector<double, blaze::rowVector> v =
+        blaze::rand<blaze::DynamicVector<double, blaze::rowVector>>(
+            columns, 0, 4);
+    blaze::DynamicMatrix<double> mresult(m.rows(), m.columns());
+
+    report("equal (matrix, row vector)",
+        measure([&]() {
+            for (std::size_t i = 0; i != m.rows(); ++i)
+            {
+                blaze::row(mresult, i) = blaze::map(blaze::row(m, i), v,
+                    [](double a, double b) { return a == b; });
+            }
+        }),
+        measure([&]() {
+            for (std::size_t i = 0; i != m.rows(); ++i)
+            {
+                blaze::row(mresult, i) = blaze::map(blaze::row(m, i), v,
+                    predicatendnd_simd<equal_simd_op>{});
+            }
+        }));
+
+    return 0;
+}
@@ -0,0 +1,648 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Time the arithmetics, booleans, matrixops, solvers and fileio primitives
+// over a sweep of operand sizes and dimensionalities (see 'benchmarks' below
+// for the covered primitives). The bandwidth (GB/s) is reported for streaming
+// kernels only, the column is left empty otherwise. The results are written
+// as CSV (default) or JSON and can be compared against a previously written
+// CSV file to detect performance regressions:
+//
+//     primitives_test --output=baseline.csv
+//     primitives_test --baseline=baseline.csv --tolerance=0.1
+//
+// The program exits with a non-zero status if any of the measurements is
+// slower than the baseline by more than the given tolerance.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// kinds of arguments passed to the benchmarked functions
+enum class arg_kind
+{
+    values,         // random doubles in [1, 2) of the benchmarked shape
+    unit_values,    // random doubles in [-0.5, 0.5) of the benchmarked shape
+    booleans,       // random booleans of the benchmarked shape
+    spd_matrix,     // diagonally dominant square matrix (2d only)
+    rhs,            // vector matching the size of the square matrix
+    extent,         // the number of elements per dimension (integer)
+    shape,          // the extent (1d) or a list of both extents (2d)
+    filename        // name of a temporary file
+};
+
+struct benchmark_info
+{
+    char const* group;
+    char const* name;
+    char const* code;               // defines 'bench' taking the arguments
+    std::vector<arg_kind> args;
+    std::vector<int> dims;          // dimensionalities to sweep
+    double bytes_per_element;       // bytes read and written per element,
+                                    // 0 for kernels which are not streaming
+    std::int64_t max_elements;      // upper limit for the sweep (0: none)
+};
+
+// element-wise functions of a single array
+#define PHYLANX_ELEMENTWISE_BENCHMARK(name, kind)                              \
+    {"matrixops", name, "define(bench, x, " name "(x))", {arg_kind::kind},    \
+        {1, 2}, 16, 0}                                                         \
+    /**/
+
+// All primitives of the arithmetics, booleans, matrixops, solvers and fileio
+// plugins are covered, except for cross() which is defined for 3-element
+// vectors only.
+std::vector<benchmark_info> const benchmarks =
+{
+    // arithmetics
+    {"arithmetics", "__add", "define(bench, x, y, x + y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 24, 0},
+    {"arithmetics", "__sub", "define(bench, x, y, x - y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 24, 0},
+    {"arithmetics", "__mul", "define(bench, x, y, x * y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 24, 0},
+    {"arithmetics", "__div", "define(bench, x, y, x / y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 24, 0},
+    {"arithmetics", "__minus", "define(bench, x, -x)",
+        {arg_kind::values}, {1, 2}, 16, 0},
+
+    // booleans
+    {"booleans", "__lt", "define(bench, x, y, x < y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__le", "define(bench, x, y, x <= y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__gt", "define(bench, x, y, x > y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__ge", "define(bench, x, y, x >= y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__eq", "define(bench, x, y, x == y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__ne", "define(bench, x, y, x != y)",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 17, 0},
+    {"booleans", "__and", "define(bench, x, y, x && y)",
+        {arg_kind::booleans, arg_kind::booleans}, {1, 2}, 3, 0},
+    {"booleans", "__or", "define(bench, x, y, x || y)",
+        {arg_kind::booleans, arg_kind::booleans}, {1, 2}, 3, 0},
+    {"booleans", "__not", "define(bench, x, !x)",
+        {arg_kind::booleans}, {1, 2}, 2, 0},
+    {"booleans", "any", "define(bench, x, any(x))",
+        {arg_kind::booleans}, {1, 2}, 1, 0},
+    {"booleans", "all", "define(bench, x, all(x))",
+        {arg_kind::booleans}, {1, 2}, 1, 0},
+    {"booleans", "where", "define(bench, c, x, y, where(c, x, y))",
+        {arg_kind::booleans, arg_kind::values, arg_kind::values}, {1, 2},
+        25, 0},
+    {"booleans", "__where_lt", "define(bench, x, y, where(x < y, x, y))",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 24, 0},
+    {"booleans", "nonzero", "define(bench, x, nonzero(x))",
+        {arg_kind::booleans}, {1, 2}, 0, 0},
+
+    // matrixops, reductions and scans
+    {"matrixops", "sum", "define(bench, x, sum(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "mean", "define(bench, x, mean(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "argmax", "define(bench, x, argmax(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "argmin", "define(bench, x, argmin(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "amax", "define(bench, x, amax(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "amin", "define(bench, x, amin(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "count_nonzero", "define(bench, x, count_nonzero(x))",
+        {arg_kind::values}, {1, 2}, 8, 0},
+    {"matrixops", "cumsum", "define(bench, x, cumsum(x))",
+        {arg_kind::values}, {1, 2}, 16, 0},
+    {"matrixops", "gradient", "define(bench, x, gradient(x))",
+        {arg_kind::values}, {1, 2}, 16, 0},
+
+    // matrixops, linear algebra (dot of two matrices is O(n^3))
+    {"matrixops", "dot", "define(bench, x, y, dot(x, y))",
+        {arg_kind::values, arg_kind::values}, {1}, 16, 0},
+    {"matrixops", "dot", "define(bench, x, y, dot(x, y))",
+        {arg_kind::values, arg_kind::values}, {2}, 0, 1 << 18},
+    {"matrixops", "transpose", "define(bench, x, transpose(x))",
+        {arg_kind::values}, {2}, 16, 0},
+    {"matrixops", "determinant", "define(bench, a, determinant(a))",
+        {arg_kind::spd_matrix}, {2}, 0, 1 << 18},
+    {"matrixops", "inverse", "define(bench, a, inverse(a))",
+        {arg_kind::spd_matrix}, {2}, 0, 1 << 18},
+    {"matrixops", "diag", "define(bench, x, diag(x))",
+        {arg_kind::values}, {2}, 0, 0},
+
+    // matrixops, creating arrays
+    {"matrixops", "constant", "define(bench, s, constant(1.0, s))",
+        {arg_kind::shape}, {1, 2}, 8, 0},
+    {"matrixops", "random", "define(bench, x, random(x))",
+        {arg_kind::values}, {1, 2}, 0, 0},
+    {"matrixops", "identity", "define(bench, n, identity(n))",
+        {arg_kind::extent}, {2}, 8, 0},
+    {"matrixops", "linspace", "define(bench, n, linspace(0.0, 1.0, n))",
+        {arg_kind::extent}, {1}, 8, 0},
+    {"matrixops", "arange", "define(bench, n, arange(0, n, 1))",
+        {arg_kind::extent}, {1}, 8, 0},
+    {"matrixops", "linearmatrix",
+        "define(bench, n, linearmatrix(n, n, 0.0, 1.0, 1.0))",
+        {arg_kind::extent}, {2}, 8, 0},
+
+    // matrixops, reshaping and copying arrays
+    {"matrixops", "hstack", "define(bench, x, y, hstack(x, y))",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 32, 0},
+    {"matrixops", "vstack", "define(bench, x, y, vstack(x, y))",
+        {arg_kind::values, arg_kind::values}, {1, 2}, 32, 0},
+    {"matrixops", "add_dim", "define(bench, x, add_dim(x))",
+        {arg_kind::values}, {1}, 16, 0},
+    {"matrixops", "shape", "define(bench, x, shape(x))",
+        {arg_kind::values}, {1, 2}, 0, 0},
+    {"matrixops", "shuffle", "define(bench, x, shuffle(x))",
+        {arg_kind::values}, {1, 2}, 16, 0},
+    {"matrixops", "slice", "define(bench, x, slice(x, list(1, -1)))",
+        {arg_kind::values}, {1}, 16, 0},
+    {"matrixops", "slice",
+        "define(bench, x, slice(x, list(1, -1), list(1, -1)))",
+        {arg_kind::values}, {2}, 16, 0},
+    {"matrixops", "slice_row", "define(bench, x, slice_row(x, 1))",
+        {arg_kind::values}, {2}, 0, 0},
+    {"matrixops", "slice_column", "define(bench, x, slice_column(x, 1))",
+        {arg_kind::values}, {2}, 0, 0},
+
+    // matrixops, element-wise functions
+    {"matrixops", "power", "define(bench, x, power(x, 2.5))",
+        {arg_kind::values}, {1, 2}, 16, 0},
+    PHYLANX_ELEMENTWISE_BENCHMARK("absolute", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("floor", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("ceil", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("trunc", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("rint", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("conj", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("real", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("imag", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("sqrt", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("invsqrt", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("cbrt", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("invcbrt", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("exp", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("exp2", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("exp10", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("log", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("log2", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("log10", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("sin", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("cos", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("tan", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arcsin", unit_values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arccos", unit_values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arctan", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arcsinh", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arccosh", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("arctanh", unit_values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("erf", values),
+    PHYLANX_ELEMENTWISE_BENCHMARK("erfc", values),
+
+    // solvers
+    {"solvers", "linear_solver_lu",
+        "define(bench, a, b, linear_solver_lu(a, b))",
+        {arg_kind::spd_matrix, arg_kind::rhs}, {2}, 0, 1 << 18},
+    {"solvers", "linear_solver_ldlt",
+        "define(bench, a, b, linear_solver_ldlt(a, b))",
+        {arg_kind::spd_matrix, arg_kind::rhs}, {2}, 0, 1 << 18},
+    {"solvers", "linear_solver_cholesky",
+        "define(bench, a, b, linear_solver_cholesky(a, b))",
+        {arg_kind::spd_matrix, arg_kind::rhs}, {2}, 0, 1 << 18},
+    {"solvers", "iterative_solver_conjugate_gradient",
+        "define(bench, a, b, iterative_solver_conjugate_gradient(a, b))",
+        {arg_kind::spd_matrix, arg_kind::rhs}, {2}, 0, 1 << 18},
+    {"solvers", "lu", "define(bench, a, lu(a))",
+        {arg_kind::spd_matrix}, {2}, 0, 1 << 18},
+
+    // fileio (write followed by read), the size of a CSV file depends on
+    // the formatting of the values
+    {"fileio", "file_write/file_read",
+        "define(bench, f, x, block(file_write(f, x), file_read(f)))",
+        {arg_kind::filename, arg_kind::values}, {1, 2}, 16, 1 << 20},
+    {"fileio", "file_write_csv/file_read_csv",
+        "define(bench, f, x, block(file_write_csv(f, x), file_read_csv(f)))",
+        {arg_kind::filename, arg_kind::values}, {2}, 0, 1 << 18},
+#if defined(PHYLANX_HAVE_HIGHFIVE)
+    {"fileio", "file_write_hdf5/file_read_hdf5",
+        "define(bench, f, x, block(file_write_hdf5(f, \"x\", x), "
+            "file_read_hdf5(f, \"x\")))",
+        {arg_kind::filename, arg_kind::values}, {1, 2}, 16, 1 << 20},
+#endif
+};
+
+#undef PHYLANX_ELEMENTWISE_BENCHMARK
+
+///////////////////////////////////////////////////////////////////////////////
+struct measurement
+{
+    std::string group;
+    std::string name;
+    int dims;
+    std::string shape;
+    std::int64_t elements;
+    std::int64_t time_ns;
+    double ns_per_element;
+    double gb_per_s;            // 0 if the kernel is not streaming
+
+    std::string key() const
+    {
+        return group + "/" + name + "/" + std::to_string(dims) + "/" + shape;
+    }
+};
+
+char const* const temporary_file = "primitives_benchmark.tmp";
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type make_argument(
+    arg_kind kind, int dims, std::size_t n)
+{
+    using phylanx::execution_tree::primitive_argument_type;
+    using phylanx::ir::node_data;
+
+    switch (kind)
+    {
+    case arg_kind::values:
+        if (dims == 1)
+        {
+            return primitive_argument_type{node_data<double>{
+                blaze::rand<blaze::DynamicVector<double>>(n, 1.0, 2.0)}};
+        }
+        return primitive_argument_type{node_data<double>{
+            blaze::rand<blaze::DynamicMatrix<double>>(n, n, 1.0, 2.0)}};
+
+    case arg_kind::unit_values:
+        if (dims == 1)
+        {
+            return primitive_argument_type{node_data<double>{
+                blaze::rand<blaze::DynamicVector<double>>(n, -0.5, 0.5)}};
+        }
+        return primitive_argument_type{node_data<double>{
+            blaze::rand<blaze::DynamicMatrix<double>>(n, n, -0.5, 0.5)}};
+
+    case arg_kind::booleans:
+        if (dims == 1)
+        {
+            blaze::DynamicVector<std::uint8_t> v(n);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                v[i] = blaze::rand<int>(0, 1);
+            }
+            return primitive_argument_type{node_data<std::uint8_t>{
+                std::move(v)}};
+        }
+        else
+        {
+            blaze::DynamicMatrix<std::uint8_t> m(n, n);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    m(i, j) = blaze::rand<int>(0, 1);
+                }
+            }
+            return primitive_argument_type{node_data<std::uint8_t>{
+                std::move(m)}};
+        }
+
+    case arg_kind::spd_matrix:
+        {
+            // symmetric and diagonally dominant, i.e. positive definite
+            blaze::DynamicMatrix<double> m =
+                blaze::rand<blaze::DynamicMatrix<double>>(n, n, 0.0, 1.0);
+            blaze::DynamicMatrix<double> a = m + blaze::trans(m);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                a(i, i) += 2.0 * n;
+            }
+            return primitive_argument_type{node_data<double>{std::move(a)}};
+        }
+
+    case arg_kind::rhs:
+        return primitive_argument_type{node_data<double>{
+            blaze::rand<blaze::DynamicVector<double>>(n, 0.0, 1.0)}};
+
+    case arg_kind::extent:
+        return primitive_argument_type{std::int64_t(n)};
+
+    case arg_kind::shape:
+        if (dims == 1)
+        {
+            return primitive_argument_type{std::int64_t(n)};
+        }
+        return primitive_argument_type{
+            phylanx::execution_tree::primitive_arguments_type{
+                primitive_argument_type{std::int64_t(n)},
+                primitive_argument_type{std::int64_t(n)}}};
+
+    case arg_kind::filename:
+        return primitive_argument_type{std::string(temporary_file)};
+
+    default:
+        break;
+    }
+
+    HPX_THROW_EXCEPTION(hpx::bad_parameter, "make_argument",
+        "unknown argument kind");
+}
+
+// Return the extents to sweep for the given dimensionality, every step
+// increases the number of elements by a factor of four.
+std::vector<std::size_t> sweep_extents(int dims, std::int64_t max_elements)
+{
+    std::vector<std::size_t> result;
+    if (dims == 1)
+    {
+        for (std::int64_t n = 1 << 8; n <= max_elements; n *= 4)
+        {
+            result.push_back(n);
+        }
+    }
+    else
+    {
+        for (std::int64_t n = 1 << 4; n * n <= max_elements; n *= 2)
+        {
+            result.push_back(n);
+        }
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<measurement> run_benchmark(benchmark_info const& info,
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::int64_t max_elements, int repetitions)
+{
+    std::vector<measurement> result;
+
+    auto const& code = phylanx::execution_tree::compile(
+        "primitives", std::string(info.code) + "\nbench", snippets);
+    auto bench = code.run();
+
+    if (info.max_elements != 0)
+    {
+        max_elements = (std::min)(max_elements, info.max_elements);
+    }
+
+    for (int dims : info.dims)
+    {
+        for (std::size_t n : sweep_extents(dims, max_elements))
+        {
+            phylanx::execution_tree::primitive_arguments_type args;
+            for (arg_kind kind : info.args)
+            {
+                args.push_back(make_argument(kind, dims, n));
+            }
+
+            // warm up, then keep the fastest of all repetitions
+            bench(args);
+
+            std::int64_t best = (std::numeric_limits<std::int64_t>::max)();
+            for (int i = 0; i != repetitions; ++i)
+            {
+                std::int64_t t = hpx::util::high_resolution_clock::now();
+                bench(args);
+                t = hpx::util::high_resolution_clock::now() - t;
+                best = (std::min)(best, t);
+            }
+            best = (std::max)(best, std::int64_t(1));
+
+            measurement m;
+            m.group = info.group;
+            m.name = info.name;
+            m.dims = dims;
+            m.shape = dims == 1 ? std::to_string(n) :
+                std::to_string(n) + "x" + std::to_string(n);
+            m.elements = static_cast<std::int64_t>(dims == 1 ? n : n * n);
+            m.time_ns = best;
+            m.ns_per_element = double(best) / m.elements;
+            m.gb_per_s = info.bytes_per_element * m.elements / best;
+
+            result.push_back(std::move(m));
+        }
+    }
+
+    std::remove(temporary_file);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void write_csv(std::ostream& os, std::vector<measurement> const& results)
+{
+    os << "group,primitive,dims,shape,elements,time_ns,ns_per_element,"
+          "gb_per_s\n";
+    for (auto const& m : results)
+    {
+        os << m.group << ',' << m.name << ',' << m.dims << ',' << m.shape
+           << ',' << m.elements << ',' << m.time_ns << ','
+           << m.ns_per_element << ',';
+        if (m.gb_per_s != 0)
+        {
+            os << m.gb_per_s;
+        }
+        os << '\n';
+    }
+}
+
+void write_json(std::ostream& os, std::vector<measurement> const& results)
+{
+    os << "[";
+    bool first = true;
+    for (auto const& m : results)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "  {\"group\": \"" << m.group << "\", \"primitive\": \""
+           << m.name << "\", \"dims\": " << m.dims << ", \"shape\": \""
+           << m.shape << "\", \"elements\": " << m.elements
+           << ", \"time_ns\": " << m.time_ns << ", \"ns_per_element\": "
+           << m.ns_per_element << ", \"gb_per_s\": ";
+        if (m.gb_per_s != 0)
+        {
+            os << m.gb_per_s;
+        }
+        else
+        {
+            os << "null";
+        }
+        os << "}";
+    }
+    os << "\n]\n";
+}
+
+// read the ns/element column of a CSV file written by write_csv
+std::map<std::string, double> read_baseline(std::string const& filename)
+{
+    std::ifstream is(filename);
+    if (!is.good())
+    {
+        HPX_THROW_EXCEPTION(hpx::filesystem_error, "read_baseline",
+            "couldn't open baseline file: " + filename);
+    }
+
+    std::map<std::string, double> result;
+
+    std::string line;
+    std::getline(is, line);     // skip header
+    while (std::getline(is, line))
+    {
+        std::vector<std::string> fields;
+        std::istringstream ls(line);
+        std::string field;
+        while (std::getline(ls, field, ','))
+        {
+            fields.push_back(field);
+        }
+        if (fields.size() < 7)
+        {
+            continue;
+        }
+
+        measurement m;
+        m.group = fields[0];
+        m.name = fields[1];
+        m.dims = std::stoi(fields[2]);
+        m.shape = fields[3];
+        result[m.key()] = std::stod(fields[6]);
+    }
+    return result;
+}
+
+// report all measurements which are slower than the baseline by more than
+// the given tolerance, returns the number of regressions found
+std::size_t compare_baseline(std::vector<measurement> const& results,
+    std::map<std::string, double> const& baseline, double tolerance)
+{
+    std::size_t regressions = 0;
+    for (auto const& m : results)
+    {
+        auto it = baseline.find(m.key());
+        if (it == baseline.end() || it->second <= 0)
+        {
+            continue;
+        }
+
+        double ratio = m.ns_per_element / it->second;
+        if (ratio > 1.0 + tolerance)
+        {
+            std::cerr << "regression: " << m.key() << ": "
+                      << m.ns_per_element << " ns/element (baseline: "
+                      << it->second << " ns/element, " << ratio << "x)\n";
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::int64_t const max_elements = vm["max-elements"].as<std::int64_t>();
+    int const repetitions = vm["repetitions"].as<int>();
+    std::string const filter = vm["filter"].as<std::string>();
+
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    std::vector<measurement> results;
+    std::size_t failures = 0;
+    for (auto const& info : benchmarks)
+    {
+        std::string name = std::string(info.group) + "/" + info.name;
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            auto r = run_benchmark(info, snippets, max_elements, repetitions);
+            results.insert(results.end(), r.begin(), r.end());
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "benchmark " << name << " failed: " << e.what()
+                      << "\n";
+            ++failures;
+        }
+    }
+
+    std::ofstream file;
+    if (vm.count("output") != 0)
+    {
+        file.open(vm["output"].as<std::string>());
+    }
+    std::ostream& os = file.is_open() ? file : std::cout;
+
+    if (vm["format"].as<std::string>() == "json")
+    {
+        write_json(os, results);
+    }
+    else
+    {
+        write_csv(os, results);
+    }
+
+    std::size_t regressions = 0;
+    if (vm.count("baseline") != 0)
+    {
+        regressions = compare_baseline(results,
+            read_baseline(vm["baseline"].as<std::string>()),
+            vm["tolerance"].as<double>());
+    }
+
+    hpx::finalize();
+    return (failures != 0 || regressions != 0) ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    using boost::program_options::value;
+
+    boost::program_options::options_description desc(
+        "usage: primitives [options]");
+    desc.add_options()
+        ("format", value<std::string>()->default_value("csv"),
+            "output format, either 'csv' or 'json' (default: csv)")
+        ("output", value<std::string>(),
+            "write the results to the given file (default: stdout)")
+        ("baseline", value<std::string>(),
+            "compare the results against the given CSV file written by an "
+            "earlier run")
+        ("tolerance", value<double>()->default_value(0.1),
+            "relative slowdown tolerated before a measurement is reported as "
+            "a regression (default: 0.1)")
+        ("max-elements", value<std::int64_t>()->default_value(1 << 20),
+            "largest number of elements of the benchmarked operands "
+            "(default: 2^20)")
+        ("repetitions", value<int>()->default_value(5),
+            "number of timed evaluations per measurement, the fastest one is "
+            "reported (default: 5)")
+        ("filter", value<std::string>()->default_value(""),
+            "run only benchmarks whose '<group>/<primitive>' name contains "
+            "the given string");
+
+    return hpx::init(desc, argc, argv);
+}
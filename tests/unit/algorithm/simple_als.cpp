@@ -136,6 +136,46 @@ char const* const als_test = R"(
     if(physl_cpp_match && physl_expected_match, true, false)
 )";
 
+///////////////////////////////////////////////////////////////////////////////
+// the same ratings as above, given in (unordered) coordinate form
+char const* const als_sparse_test = R"(
+    define(ratings,[[0.0,4.0,0.0,0.0,0.0],
+                    [1.0,0.0,4.0,0.0,5.0],
+                    [0.0,0.0,0.0,2.0,0.0],
+                    [0.0,8.0,0.0,0.0,0.0],
+                    [0.0,0.0,4.0,0.0,0.0],
+                    [0.0,0.0,0.0,0.0,0.0],
+                    [0.0,0.0,0.0,0.0,2.0],
+                    [1.0,0.0,0.0,0.0,0.0],
+                    [0.0,0.0,0.0,5.0,0.0],
+                    [1.0,0.0,0.0,2.0,0.0]])
+    define(users, [9, 1, 0, 1, 2, 3, 4, 6, 7, 8, 9, 1])
+    define(items, [3, 4, 1, 0, 3, 1, 2, 4, 0, 3, 0, 2])
+    define(values, [2.0, 5.0, 4.0, 1.0, 2.0, 8.0, 4.0, 2.0, 1.0, 5.0, 1.0, 4.0])
+
+    define(result_dense, als(ratings, 0.1, 3, 10, 40, 0))
+    define(result_sparse,
+        als(make_list(users, items, values, 10, 5), 0.1, 3, 10, 40, 0))
+
+    define(X_diff, sum(absolute(
+        slice(result_dense, 0) - slice(result_sparse, 0))))
+    define(Y_diff, sum(absolute(
+        slice(result_dense, 1) - slice(result_sparse, 1))))
+
+    if((X_diff < 1e-10) && (Y_diff < 1e-10), true, false)
+)";
+
+void test_als_sparse()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code =
+        phylanx::execution_tree::compile(als_sparse_test, snippets);
+    auto als = code.run();
+
+    HPX_TEST_EQ(phylanx::execution_tree::extract_boolean_value(als),
+        phylanx::ir::node_data<uint8_t>{1});
+}
+
 void test_als_physl()
 {
     phylanx::execution_tree::compiler::function_list snippets;
@@ -149,5 +189,6 @@ void test_als_physl()
 int main(int argc, char* argv[])
 {
     test_als_physl();
+    test_als_sparse();
     return hpx::util::report_errors();
 }
@@ -8,8 +8,15 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
-#include <utility>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <blaze/Math.h>
 
@@ -85,9 +92,116 @@ void test_lra()
     HPX_TEST_EQ(std::move(expected), std::move(actual));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+blaze::DynamicMatrix<double> lra_x()
+{
+    return blaze::DynamicMatrix<double>{
+        {15.04, 16.74}, {13.82, 24.49}, {12.54, 16.32}, {23.09, 19.83},
+        {9.268, 12.87}, {9.676, 13.14}, {12.22, 20.04}, {11.06, 17.12},
+        {16.3, 15.7}, {15.46, 23.95}, {11.74, 14.69}, {14.81, 14.7},
+        {13.4, 20.52}, {14.58, 13.66}, {15.05, 19.07}, {11.34, 18.61},
+        {18.31, 20.58}, {19.89, 20.26}, {12.88, 18.22}, {12.75, 16.7},
+        {9.295, 13.9}, {24.63, 21.6}, {11.26, 19.83}, {13.71, 18.68},
+        {9.847, 15.68}, {8.571, 13.1}, {13.46, 18.75}, {12.34, 12.27},
+        {13.94, 13.17}, {12.07, 13.44}};
+}
+
+blaze::DynamicVector<double> lra_y()
+{
+    return blaze::DynamicVector<double>{1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1,
+        0, 1, 0, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1};
+}
+
+// sequential mini-batch gradient descent, visiting the rows in the same
+// order as the lra primitive (which shuffles using std::mt19937 seeded
+// with zero)
+blaze::DynamicVector<double> lra_reference(double alpha,
+    std::int64_t iterations, std::size_t batch_size, bool shuffle)
+{
+    blaze::DynamicMatrix<double> x = lra_x();
+    blaze::DynamicVector<double> y = lra_y();
+
+    blaze::DynamicVector<double> weights(x.columns(), 0.0);
+    blaze::DynamicVector<double> gradient(x.columns());
+
+    std::vector<std::size_t> order(x.rows());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+
+    std::mt19937 rng{std::uint32_t(0)};
+    for (std::int64_t step = 0; step != iterations; ++step)
+    {
+        if (shuffle)
+        {
+            std::shuffle(order.begin(), order.end(), rng);
+        }
+
+        for (std::size_t begin = 0; begin < x.rows(); begin += batch_size)
+        {
+            std::size_t end = (std::min)(begin + batch_size, x.rows());
+
+            gradient = 0.0;
+            for (std::size_t i = begin; i != end; ++i)
+            {
+                auto row = blaze::trans(blaze::row(x, order[i]));
+                double pred = 1.0 / (1.0 + std::exp(-blaze::dot(row, weights)));
+                gradient += (pred - y[order[i]]) * row;
+            }
+
+            weights -= alpha * gradient;
+        }
+    }
+    return weights;
+}
+
+blaze::DynamicVector<double> run_lra_primitive(std::string const& options)
+{
+    std::string code_str =
+        "block(define(f, x, y, lra(x, y, " + options + ")), f)";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(code_str, snippets);
+    auto lra = code.run();
+
+    auto result = lra(phylanx::ir::node_data<double>{lra_x()},
+        phylanx::ir::node_data<double>{lra_y()});
+
+    return phylanx::execution_tree::extract_numeric_value(result).vector();
+}
+
+void test_lra_primitive()
+{
+    // full batch gradient descent, same as the PhySL implementation above
+    auto weights = run_lra_primitive("1e-5, 750");
+    HPX_TEST(std::abs(weights[0] + 0.0152777) < 1e-6);
+    HPX_TEST(std::abs(weights[1] - 0.0505757) < 1e-6);
+
+    // a batch covering all rows is the same as a full batch
+    HPX_TEST_EQ(weights, run_lra_primitive("1e-5, 750, false, 30"));
+    HPX_TEST_EQ(weights, run_lra_primitive("1e-5, 750, false, 0"));
+
+    // the weights change by less than the tolerance after the first step
+    HPX_TEST_EQ(run_lra_primitive("1e-5, 1"),
+        run_lra_primitive("1e-5, 750, false, 0, false, 1.0"));
+
+    // the full batch result matches the sequential reference
+    auto expected = lra_reference(1e-5, 750, 30, false);
+    HPX_TEST((blaze::max)(blaze::abs(weights - expected)) < 1e-12);
+
+    // mini-batches, visiting the rows in order and shuffled
+    auto batched = run_lra_primitive("1e-5, 750, false, 7");
+    expected = lra_reference(1e-5, 750, 7, false);
+    HPX_TEST((blaze::max)(blaze::abs(batched - expected)) < 1e-12);
+
+    auto shuffled = run_lra_primitive("1e-5, 750, false, 7, true");
+    expected = lra_reference(1e-5, 750, 7, true);
+    HPX_TEST((blaze::max)(blaze::abs(shuffled - expected)) < 1e-12);
+    HPX_TEST((blaze::max)(blaze::abs(shuffled - batched)) > 0.0);
+}
+
 int main(int argc, char* argv[])
 {
   test_lra();
+  test_lra_primitive();
   return hpx::util::report_errors();
 }
 
@@ -0,0 +1,100 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// All localities run the same code, the collectives match the contributions
+// by the names of the primitives.
+phylanx::execution_tree::compiler::function compile(
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::string const& codestr)
+{
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    return code.run();
+}
+
+void test_collectives(std::uint32_t site, std::uint32_t num_sites)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    auto all_reduce_sum =
+        compile(snippets, "block(define(f, x, all_reduce(x)), f)");
+    auto all_reduce_max =
+        compile(snippets, R"(block(define(f, x, all_reduce(x, "max")), f))");
+    auto broadcast =
+        compile(snippets, "block(define(f, x, broadcast(x, 1)), f)");
+    auto gather = compile(snippets, "block(define(f, x, gather(x)), f)");
+
+    // invoke twice to make sure subsequent collectives don't interfere
+    for (int i = 0; i != 2; ++i)
+    {
+        blaze::DynamicVector<double> v{double(site + 1), 1.0};
+        auto sum = phylanx::execution_tree::extract_numeric_value(
+            all_reduce_sum(
+                phylanx::execution_tree::primitive_argument_type{v}));
+
+        blaze::DynamicVector<double> expected{
+            double(num_sites * (num_sites + 1) / 2), double(num_sites)};
+        HPX_TEST_EQ(sum, phylanx::ir::node_data<double>(expected));
+
+        auto max = phylanx::execution_tree::extract_scalar_integer_value(
+            all_reduce_max(phylanx::execution_tree::primitive_argument_type{
+                std::int64_t(site)}));
+        HPX_TEST_EQ(max, std::int64_t(num_sites - 1));
+
+        auto root = phylanx::execution_tree::extract_scalar_integer_value(
+            broadcast(phylanx::execution_tree::primitive_argument_type{
+                std::int64_t(site)}));
+        HPX_TEST_EQ(root, std::int64_t(1));
+
+        auto gathered = gather(phylanx::execution_tree::
+            primitive_argument_type{std::int64_t(site)});
+        if (site == 0)
+        {
+            auto values = phylanx::execution_tree::extract_list_value(
+                gathered).copy();
+            HPX_TEST_EQ(values.size(), std::size_t(num_sites));
+            for (std::size_t j = 0; j != values.size(); ++j)
+            {
+                HPX_TEST_EQ(phylanx::execution_tree::
+                    extract_scalar_integer_value(values[j]), std::int64_t(j));
+            }
+        }
+        else
+        {
+            HPX_TEST(!phylanx::execution_tree::valid(gathered));
+        }
+    }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    std::uint32_t num_sites = hpx::get_num_localities(hpx::launch::sync);
+    HPX_TEST(num_sites >= 2);
+
+    test_collectives(hpx::get_locality_id(), num_sites);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // run hpx_main on all localities
+    std::vector<std::string> const cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
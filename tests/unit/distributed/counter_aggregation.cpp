@@ -0,0 +1,87 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(x, constant(1.0, make_list(10, 10))),
+    define(y, x + x),
+    y + y
+))";
+
+void run_on(phylanx::execution_tree::compiler::function_list& snippets,
+    std::uint32_t locality_id)
+{
+    hpx::id_type locality = hpx::naming::get_id_from_locality_id(locality_id);
+
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment(locality);
+
+    auto const& program =
+        phylanx::execution_tree::compile(code, snippets, env, locality);
+
+    auto result = program.run();
+    HPX_TEST_EQ(4.0,
+        phylanx::execution_tree::extract_numeric_value(result).at(0, 0));
+}
+
+void test_counter_aggregation()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    run_on(snippets, 0);
+    run_on(snippets, 1);
+
+    phylanx::util::counter_data_summary data =
+        phylanx::util::retrieve_all_counter_data(
+            std::vector<std::string>{"count/eval"}).get();
+
+    HPX_TEST_EQ(data.counter_names.size(), std::size_t(1));
+    HPX_TEST_EQ(data.load_imbalance.size(), std::size_t(1));
+    HPX_TEST(data.load_imbalance[0] >= 1.0);
+
+    // both localities have evaluated the same primitives
+    HPX_TEST(data.localities.size() >= 2);
+    HPX_TEST(data.localities[0][0] != 0);
+    HPX_TEST_EQ(data.localities[0][0], data.localities[1][0]);
+
+    // the per-type values are accumulated over all instances
+    std::int64_t add_count = 0;
+    for (auto const& entry : data.instances)
+    {
+        auto const tags =
+            phylanx::execution_tree::compiler::parse_primitive_name(
+                entry.first);
+        if (tags.primitive == "__add")
+        {
+            add_count += entry.second[0];
+        }
+    }
+    HPX_TEST_EQ(add_count, std::int64_t(4));
+    HPX_TEST_EQ(data.primitives["__add"][0], add_count);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST(hpx::get_num_localities(hpx::launch::sync) >= 2);
+
+    test_counter_aggregation();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
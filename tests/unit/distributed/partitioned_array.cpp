@@ -0,0 +1,111 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::string const data = R"(
+    define(m, vstack(
+        hstack(1., 2., 3., 4.),
+        hstack(5., 6., 7., 8.),
+        hstack(9., 10., 11., 12.)
+    )),
+    define(v, hstack(1., 2., 3., 4.)),
+    define(w, hstack(3., 2., 1.))
+)";
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(
+        "block(" + data + ", " + codestr + ")", snippets, env);
+    return code.run();
+}
+
+void test_partitioned(std::string const& code, std::string const& expected)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST(hpx::get_num_localities(hpx::launch::sync) >= 2);
+
+    // distributing and collecting data
+    test_partitioned("unpartition(partition(m))", "m");
+    test_partitioned("unpartition(partition(m, 3))", "m");
+    test_partitioned("unpartition(partition(v))", "v");
+    test_partitioned("unpartition(m)", "m");
+
+    // elementwise operations
+    test_partitioned(
+        "unpartition(add_d(partition(m), partition(m)))", "m + m");
+    test_partitioned(
+        "unpartition(sub_d(partition(m, 3), m))", "m - m");
+    test_partitioned("unpartition(mul_d(2., partition(v)))", "2. * v");
+    test_partitioned("unpartition(div_d(partition(m), v))", "m / v");
+    test_partitioned("add_d(m, v)", "m + v");
+
+    // dot products
+    test_partitioned("unpartition(dot_d(partition(m), v))", "dot(m, v)");
+    test_partitioned(
+        "unpartition(dot_d(partition(m, 3), transpose(m)))",
+        "dot(m, transpose(m))");
+    test_partitioned("dot_d(partition(v), partition(v))", "dot(v, v)");
+    test_partitioned("dot_d(partition(v), v)", "dot(v, v)");
+    test_partitioned("dot_d(w, partition(m))", "dot(w, m)");
+    test_partitioned("dot_d(partition(w), m)", "dot(w, m)");
+    test_partitioned("dot_d(partition(w, 3), m)", "dot(w, m)");
+    test_partitioned("unpartition(dot_d(partition(v), 2.))", "dot(v, 2.)");
+    test_partitioned("unpartition(dot_d(2., partition(v)))", "dot(2., v)");
+    test_partitioned(
+        "unpartition(dot_d(2., partition(m, 3)))", "dot(2., m)");
+
+    // reductions and transposition
+    test_partitioned("sum_d(partition(m))", "sum(m)");
+    test_partitioned("sum_d(partition(v, 3))", "sum(v)");
+    test_partitioned(
+        "unpartition(transpose_d(partition(m)))", "transpose(m)");
+    test_partitioned(
+        "unpartition(transpose_d(partition(m, 3)))", "transpose(m)");
+    test_partitioned(
+        "unpartition(transpose_d(transpose_d(partition(m))))", "m");
+
+    // the local primitives forward partitioned operands
+    test_partitioned("unpartition(partition(m) + partition(m))", "m + m");
+    test_partitioned("unpartition(partition(m, 3) - m - m)", "m - m - m");
+    test_partitioned("unpartition(2. * partition(v))", "2. * v");
+    test_partitioned("unpartition(partition(m) / v)", "m / v");
+    test_partitioned("unpartition(dot(partition(m), v))", "dot(m, v)");
+    test_partitioned("sum(partition(m))", "sum(m)");
+    test_partitioned("unpartition(transpose(partition(m)))", "transpose(m)");
+
+    // creating partitioned arrays in place
+    test_partitioned("unpartition(constant_d(2., make_list(3, 4)))",
+        "constant(2., make_list(3, 4))");
+    test_partitioned("unpartition(constant_d(2., make_list(5), 3))",
+        "constant(2., make_list(5))");
+    test_partitioned("sum(constant_d(1., make_list(100, 10), 4))", "1000.");
+    test_partitioned("unpartition(constant_d(1., make_list(3, 4)) + m)",
+        "1. + m");
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
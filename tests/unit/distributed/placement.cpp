@@ -0,0 +1,150 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// Find the placement decision for the first primitive of the given type
+phylanx::execution_tree::compiler::placement_entry const* find_placement(
+    phylanx::execution_tree::compiler::function_list const& snippets,
+    std::string const& type)
+{
+    for (auto const& entry : snippets.placement_.entries)
+    {
+        phylanx::execution_tree::compiler::primitive_name_parts name_parts;
+        if (phylanx::execution_tree::compiler::parse_primitive_name(
+                entry.name, name_parts) &&
+            name_parts.primitive == type)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_placement_follows_data()
+{
+    std::string const code = R"(block(
+        define(a, on_locality(1, [1.0, 2.0, 3.0])),
+        define(b, on_locality(1, [4.0, 5.0, 6.0])),
+        a + b
+    ))";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    snippets.placement_.enabled = true;
+
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment(
+            hpx::naming::get_id_from_locality_id(0));
+
+    auto const& program =
+        phylanx::execution_tree::compile(code, snippets, env);
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        program.run());
+
+    blaze::DynamicVector<double> expected{5.0, 7.0, 9.0};
+    HPX_TEST_EQ(result, phylanx::ir::node_data<double>(std::move(expected)));
+
+    // both operands live on locality 1, so should the addition
+    auto const* entry = find_placement(snippets, "__add");
+    HPX_TEST(entry != nullptr);
+    if (entry != nullptr)
+    {
+        HPX_TEST_EQ(entry->locality, std::uint32_t(1));
+        HPX_TEST_EQ(entry->remote_operands, std::size_t(0));
+    }
+}
+
+void test_placement_prefers_default()
+{
+    std::string const code = R"(block(
+        define(a, on_locality(1, [1.0, 2.0, 3.0])),
+        define(b, [4.0, 5.0, 6.0]),
+        a + b
+    ))";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    snippets.placement_.enabled = true;
+
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment(
+            hpx::naming::get_id_from_locality_id(0));
+
+    auto const& program =
+        phylanx::execution_tree::compile(code, snippets, env);
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        program.run());
+
+    blaze::DynamicVector<double> expected{5.0, 7.0, 9.0};
+    HPX_TEST_EQ(result, phylanx::ir::node_data<double>(std::move(expected)));
+
+    // ties are resolved in favor of the default locality, the operand
+    // living on locality 1 is reported as cross-locality traffic
+    auto const* entry = find_placement(snippets, "__add");
+    HPX_TEST(entry != nullptr);
+    if (entry != nullptr)
+    {
+        HPX_TEST_EQ(entry->locality, std::uint32_t(0));
+        HPX_TEST_EQ(entry->remote_operands, std::size_t(1));
+    }
+    HPX_TEST(snippets.placement_.cross_locality_operands() != 0);
+    HPX_TEST(!phylanx::execution_tree::compiler::format_placement_report(
+        snippets.placement_).empty());
+}
+
+void test_placement_not_recorded_by_default()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compile(R"(block(
+        define(a, on_locality(1, [1.0, 2.0, 3.0])),
+        a + a
+    ))", snippets);
+
+    HPX_TEST(snippets.placement_.entries.empty());
+}
+
+void test_placement_invalid_locality()
+{
+    bool exception_thrown = false;
+    try
+    {
+        phylanx::execution_tree::compiler::function_list snippets;
+        phylanx::execution_tree::compile(
+            "define(a, on_locality(42, 1.0))", snippets);
+    }
+    catch (hpx::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST(hpx::get_num_localities(hpx::launch::sync) >= 2);
+
+    test_placement_follows_data();
+    test_placement_prefers_default();
+    test_placement_not_recorded_by_default();
+    test_placement_invalid_locality();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test is run with --hpx:ini=phylanx.auto_parallel_block=1
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/agas.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t count_parallel_blocks()
+{
+    return hpx::agas::find_symbols(
+        hpx::launch::sync, "/phylanx/parallel_block$*").size();
+}
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    return code.run();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_independent_statements()
+{
+    std::size_t count = count_parallel_blocks();
+
+    auto result = compile_and_run(R"(block(
+            define(x, 1.0),
+            define(y, 2.0),
+            define(z, 3.0),
+            x + y + z
+        ))");
+
+    HPX_TEST_EQ(
+        6.0, phylanx::execution_tree::extract_numeric_value(result)[0]);
+    HPX_TEST_EQ(count + 1, count_parallel_blocks());
+}
+
+void test_dependent_statements()
+{
+    std::size_t count = count_parallel_blocks();
+
+    auto result = compile_and_run(R"(block(
+            define(x, 1.0),
+            define(y, x + 1.0),
+            store(x, y + 1.0),
+            x
+        ))");
+
+    HPX_TEST_EQ(
+        3.0, phylanx::execution_tree::extract_numeric_value(result)[0]);
+    HPX_TEST_EQ(count, count_parallel_blocks());
+}
+
+void test_mixed_statements()
+{
+    std::size_t count = count_parallel_blocks();
+
+    // the two loops are independent of each other, the final statement
+    // depends on both
+    auto result = compile_and_run(R"(block(
+            define(x, 0),
+            define(y, 0),
+            while(x < 10, store(x, x + 1)),
+            while(y < 20, store(y, y + 2)),
+            x + y
+        ))");
+
+    HPX_TEST_EQ(
+        30, phylanx::execution_tree::extract_integer_value(result)[0]);
+    HPX_TEST_EQ(count + 2, count_parallel_blocks());
+}
+
+void test_side_effects()
+{
+    std::size_t count = count_parallel_blocks();
+
+    // calls to user defined functions and I/O are never reordered
+    auto result = compile_and_run(R"(block(
+            define(x, 1),
+            define(inc, a, store(x, x + a)),
+            inc(1),
+            cout(x),
+            define(y, 2),
+            x + y
+        ))");
+
+    HPX_TEST_EQ(
+        4, phylanx::execution_tree::extract_integer_value(result)[0]);
+    HPX_TEST_EQ(count, count_parallel_blocks());
+}
+
+int main(int argc, char* argv[])
+{
+    test_independent_statements();
+    test_dependent_statements();
+    test_mixed_statements();
+    test_side_effects();
+
+    return hpx::util::report_errors();
+}
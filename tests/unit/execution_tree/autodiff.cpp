@@ -0,0 +1,207 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> compile_and_run(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    return phylanx::execution_tree::extract_numeric_value(code.run());
+}
+
+bool near(double lhs, double rhs)
+{
+    return std::abs(lhs - rhs) < 1e-10;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_elementwise()
+{
+    // d/dx sum(x * y) = y
+    auto result = compile_and_run(R"(block(
+            define(f, x, y, sum(x * y)),
+            define(df, grad(f, x)),
+            df([1.0, 2.0, 3.0], [4.0, 5.0, 6.0])
+        ))");
+
+    HPX_TEST_EQ(result.size(), std::size_t(3));
+    HPX_TEST(near(result.vector()[0], 4.0));
+    HPX_TEST(near(result.vector()[1], 5.0));
+    HPX_TEST(near(result.vector()[2], 6.0));
+}
+
+void test_scalar_chain()
+{
+    // d/dx (exp(2x) + log(x) - x / 2) = 2 exp(2x) + 1/x - 1/2
+    auto result = compile_and_run(R"(block(
+            define(f, x, exp(2.0 * x) + log(x) - x / 2.0),
+            define(df, grad(f, x)),
+            df(1.5)
+        ))");
+
+    HPX_TEST(near(result[0], 2.0 * std::exp(3.0) + 1.0 / 1.5 - 0.5));
+}
+
+void test_local_variables()
+{
+    // the local variable t is used twice: d/dx (x^2 * x) = 3 x^2
+    auto result = compile_and_run(R"(block(
+            define(df, grad(lambda(x, block(define(t, x * x), t * x)), x)),
+            df(2.0)
+        ))");
+
+    HPX_TEST(near(result[0], 12.0));
+}
+
+void test_logistic_regression()
+{
+    // the gradient of the cross entropy loss of a logistic regression is
+    // transpose(X) . (sigmoid(X . w) - y)
+    auto result = compile_and_run(R"(block(
+            define(loss, w, X, y, block(
+                define(p, 1.0 / (1.0 + exp(-dot(X, w)))),
+                -sum(y * log(p) + (1.0 - y) * log(1.0 - p))
+            )),
+            define(dloss, grad(loss, w)),
+            define(X, [[1.0, 2.0], [3.0, -1.0], [-2.0, 0.5]]),
+            define(y, [1.0, 0.0, 1.0]),
+            define(w, [0.1, -0.2]),
+            define(expected,
+                dot(transpose(X), 1.0 / (1.0 + exp(-dot(X, w))) - y)),
+            dloss(w, X, y) - expected
+        ))");
+
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+    HPX_TEST(near(result.vector()[0], 0.0));
+    HPX_TEST(near(result.vector()[1], 0.0));
+}
+
+void test_matrix_argument()
+{
+    // d/dA sum(dot(A, v)) = outer(ones, v)
+    auto result = compile_and_run(R"(block(
+            define(f, A, v, sum(dot(A, v))),
+            define(df, grad(f, A)),
+            df([[1.0, 2.0], [3.0, 4.0]], [5.0, 6.0])
+        ))");
+
+    HPX_TEST(near(result.matrix()(0, 0), 5.0));
+    HPX_TEST(near(result.matrix()(0, 1), 6.0));
+    HPX_TEST(near(result.matrix()(1, 0), 5.0));
+    HPX_TEST(near(result.matrix()(1, 1), 6.0));
+}
+
+void test_slicing()
+{
+    auto result = compile_and_run(R"(block(
+            define(f, x, 3.0 * slice(x, 1) + mean(x)),
+            define(df, grad(f, x)),
+            df([1.0, 2.0, 3.0, 4.0])
+        ))");
+
+    HPX_TEST(near(result.vector()[0], 0.25));
+    HPX_TEST(near(result.vector()[1], 3.25));
+    HPX_TEST(near(result.vector()[2], 0.25));
+    HPX_TEST(near(result.vector()[3], 0.25));
+}
+
+void test_concurrent_calls()
+{
+    // the gradient function is invoked concurrently by parallel_map
+    auto result = compile_and_run(R"(block(
+            define(f, x, sum(x * x)),
+            define(df, grad(f, x)),
+            define(dfs, parallel_map(lambda(a, sum(df(a))), list(
+                [1.0, 2.0], [3.0, 4.0], [5.0, 6.0], [7.0, 8.0]))),
+            hstack(slice(dfs, 0), slice(dfs, 1), slice(dfs, 2),
+                slice(dfs, 3)) + df([1.0, 1.0, 1.0, 1.0])
+        ))");
+
+    HPX_TEST_EQ(result.size(), std::size_t(4));
+    HPX_TEST(near(result.vector()[0], 8.0));
+    HPX_TEST(near(result.vector()[1], 16.0));
+    HPX_TEST(near(result.vector()[2], 24.0));
+    HPX_TEST(near(result.vector()[3], 32.0));
+}
+
+void test_scoped_definitions()
+{
+    // grad() differentiates the definition of f visible at its location
+    auto result = compile_and_run(R"(block(
+            define(f, x, x * x),
+            define(g, y, block(
+                define(f, x, 3.0 * x),
+                define(dg, grad(f, x)),
+                dg(y)
+            )),
+            define(df, grad(f, x)),
+            hstack(g(2.0), df(2.0))
+        ))");
+
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+    HPX_TEST(near(result.vector()[0], 3.0));
+    HPX_TEST(near(result.vector()[1], 4.0));
+}
+
+void test_leaves_evaluated_once()
+{
+    // g(y) does not depend on x, it is evaluated once even though its value
+    // is used by the forward and the backward sweep
+    auto result = compile_and_run(R"(block(
+            define(calls, 0),
+            define(g, y, block(store(calls, calls + 1), y)),
+            define(f, x, y, block(define(t, g(y) * 2.0), x * t * x)),
+            define(df, grad(f, x)),
+            define(r, df(2.0, 3.0)),
+            hstack(r, calls)
+        ))");
+
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+    HPX_TEST(near(result.vector()[0], 24.0));
+    HPX_TEST(near(result.vector()[1], 1.0));
+}
+
+void test_not_differentiable()
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(R"(block(
+                define(f, x, argmax(x) * 1.0),
+                define(df, grad(f, x)),
+                df([1.0, 2.0])
+            ))");
+    }
+    catch (hpx::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+int main(int argc, char* argv[])
+{
+    test_elementwise();
+    test_scalar_chain();
+    test_local_variables();
+    test_logistic_regression();
+    test_matrix_argument();
+    test_slicing();
+    test_concurrent_calls();
+    test_scoped_definitions();
+    test_leaves_evaluated_once();
+    test_not_differentiable();
+
+    return hpx::util::report_errors();
+}
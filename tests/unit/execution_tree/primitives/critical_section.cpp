@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_critical_section()
+{
+    // all invocations of f share the variable 'scratch'
+    std::string const code = R"(block(
+        define(scratch, 0.0),
+        define(f, x, critical(block(
+            store(scratch, x),
+            scratch * scratch
+        ))),
+        parallel_map(f, list(1., 2., 3., 4., 5., 6., 7., 8.))
+    ))";
+
+    auto result =
+        phylanx::execution_tree::extract_list_value(compile_and_run(code));
+
+    HPX_TEST_EQ(result.size(), std::size_t(8));
+
+    double expected = 1.0;
+    for (auto const& val : result)
+    {
+        HPX_TEST_EQ(
+            phylanx::execution_tree::extract_scalar_numeric_value(val),
+            expected * expected);
+        expected += 1.0;
+    }
+}
+
+void test_critical_section_result()
+{
+    // the result must not be affected by later evaluations
+    std::string const code = R"(block(
+        define(scratch, hstack(0.0, 0.0)),
+        define(f, x, critical(block(
+            store(scratch, x),
+            scratch
+        ))),
+        f(hstack(1.0, 2.0)) + f(hstack(3.0, 4.0))
+    ))";
+
+    auto result =
+        phylanx::execution_tree::extract_numeric_value(compile_and_run(code));
+
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+    HPX_TEST_EQ(result[0], 4.0);
+    HPX_TEST_EQ(result[1], 6.0);
+}
+
+int main(int argc, char* argv[])
+{
+    test_critical_section();
+    test_critical_section_result();
+
+    return hpx::util::report_errors();
+}
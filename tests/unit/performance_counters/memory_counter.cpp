@@ -0,0 +1,116 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(x, constant(1.0, make_list(100, 10))),
+    define(y, x + x),
+    y
+))";
+
+std::vector<std::string> const counter_names{
+    "memory/allocated", "memory/largest_result", "count/copies"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_scoped_copy_count()
+{
+    blaze::DynamicMatrix<double> m(10, 10, 1.0);
+    phylanx::ir::node_data<double> data{m};
+
+    std::int64_t copies = 0;
+    {
+        phylanx::ir::scoped_copy_count scope(&copies);
+
+        phylanx::ir::node_data<double> copy1{data};
+
+        // the count stays with this HPX thread, even if it is resumed on a
+        // different worker thread
+        hpx::this_thread::yield();
+
+        phylanx::ir::node_data<double> copy2{m};
+
+        // copies performed by other HPX threads are not attributed
+        hpx::async([&]() { phylanx::ir::node_data<double> copy3{m}; }).get();
+
+        std::int64_t inner_copies = 0;
+        {
+            phylanx::ir::scoped_copy_count inner_scope(&inner_copies);
+            phylanx::ir::node_data<double> copy4{data};
+        }
+        HPX_TEST_EQ(inner_copies, std::int64_t(1));
+    }
+
+    phylanx::ir::node_data<double> copy5{data};
+
+    HPX_TEST_EQ(copies, std::int64_t(2));
+}
+
+int main()
+{
+    // Compile the given code
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& compiled = phylanx::execution_tree::compile(
+        phylanx::ast::generate_ast(code), snippets);
+
+    std::vector<std::string> existing_primitive_instances =
+        phylanx::util::enable_measurements();
+
+    auto result = compiled.run();
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(result).at(0, 0));
+
+    std::int64_t const matrix_bytes = 100 * 10 * sizeof(double);
+
+    for (auto const& entry :
+        phylanx::util::retrieve_counter_data(
+            existing_primitive_instances, counter_names))
+    {
+        HPX_TEST_EQ(entry.second.size(), counter_names.size());
+
+        auto const tags =
+            phylanx::execution_tree::compiler::parse_primitive_name(
+                entry.first);
+
+        // both, constant and __add allocate a new matrix
+        if (tags.primitive == "constant" || tags.primitive == "__add")
+        {
+            HPX_TEST_EQ(entry.second[0], matrix_bytes);
+            HPX_TEST_EQ(entry.second[1], matrix_bytes);
+        }
+
+        // variables hand out references to the data they hold
+        if (tags.primitive == "access-variable")
+        {
+            HPX_TEST_EQ(entry.second[0], 0);
+        }
+
+        // none of these primitives has to copy any data
+        if (tags.primitive == "constant" || tags.primitive == "__add" ||
+            tags.primitive == "access-variable")
+        {
+            HPX_TEST_EQ(entry.second[2], 0);
+        }
+
+        HPX_TEST(entry.second[1] <= entry.second[0]);
+    }
+
+    test_scoped_copy_count();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,82 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(x, constant(1.0, make_list(100, 10))),
+    define(y, x + x),
+    y
+))";
+
+int main()
+{
+    using phylanx::execution_tree::primitives::primitive_component_base;
+
+    HPX_TEST_EQ(primitive_component_base::size_class(0), std::size_t(0));
+    HPX_TEST_EQ(primitive_component_base::size_class(1), std::size_t(0));
+    HPX_TEST_EQ(primitive_component_base::size_class(2), std::size_t(1));
+    HPX_TEST_EQ(primitive_component_base::size_class(1000), std::size_t(9));
+    HPX_TEST_EQ(primitive_component_base::size_class(1024), std::size_t(10));
+    HPX_TEST_EQ(primitive_component_base::size_class(std::int64_t(1) << 62),
+        primitive_component_base::num_size_classes - 1);
+
+    // Compile the given code
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& compiled = phylanx::execution_tree::compile(
+        phylanx::ast::generate_ast(code), snippets);
+
+    phylanx::util::enable_measurements(true);
+
+    auto result = compiled.run();
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(result).at(0, 0));
+
+    // the 100x10 matrices fall into size class 9 (512 <= 1000 < 1024)
+    bool found_add = false;
+    for (auto const& entry : phylanx::util::retrieve_size_histogram())
+    {
+        HPX_TEST_EQ(entry.second.size(),
+            primitive_component_base::num_size_classes);
+
+        auto const tags =
+            phylanx::execution_tree::compiler::parse_primitive_name(
+                entry.first);
+
+        if (tags.primitive == "constant" || tags.primitive == "__add")
+        {
+            found_add = found_add || tags.primitive == "__add";
+
+            for (std::size_t k = 0; k != entry.second.size(); ++k)
+            {
+                HPX_TEST_EQ(entry.second[k].first, k == 9 ? 1 : 0);
+                HPX_TEST_EQ(entry.second[k].second != 0, k == 9);
+            }
+        }
+    }
+    HPX_TEST(found_add);
+
+    // the same data is exposed through performance counter instances
+    hpx::performance_counters::performance_counter counter(
+        "/phylanx{locality#0/size_class#9}/primitives/__add/count/eval");
+    std::vector<std::int64_t> values =
+        counter.get_counter_values_array(hpx::launch::sync, false).values_;
+
+    HPX_TEST_EQ(values.size(), std::size_t(1));
+    HPX_TEST_EQ(values[0], 1);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+std::string compiled_name(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    return phylanx::execution_tree::compile(codestr, snippets, env).name_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the fused evaluation with where() applied to the materialized
+// condition
+void test_fused_where(std::string const& cond, std::string const& a,
+    std::string const& b)
+{
+    std::string fused = "where(" + cond + ", " + a + ", " + b + ")";
+    std::string unfused = "block(define(cond, " + cond + "), where(cond, " +
+        a + ", " + b + "))";
+
+    HPX_TEST_EQ(compile_and_run(fused), compile_and_run(unfused));
+}
+
+void test_compiler_recognition()
+{
+    HPX_TEST(compiled_name("where(1 == 2, 1, 2)").find("__where_eq") !=
+        std::string::npos);
+    HPX_TEST(compiled_name("where(1 != 2, 1, 2)").find("__where_ne") !=
+        std::string::npos);
+    HPX_TEST(compiled_name("where(1 < 2, 1, 2)").find("__where_lt") !=
+        std::string::npos);
+    HPX_TEST(compiled_name("where(1 <= 2, 1, 2)").find("__where_le") !=
+        std::string::npos);
+    HPX_TEST(compiled_name("where(1 > 2, 1, 2)").find("__where_gt") !=
+        std::string::npos);
+    HPX_TEST(compiled_name("where(1 >= 2, 1, 2)").find("__where_ge") !=
+        std::string::npos);
+
+    // a condition which is not a comparison is not fused
+    HPX_TEST(compiled_name("where(true, 1, 2)").find("__where_") ==
+        std::string::npos);
+}
+
+void test_fused_where_0d()
+{
+    test_fused_where("1 > 2", "1", "2");
+    test_fused_where("1. <= 2", "1.", "2");
+    test_fused_where("3 == 3", "true", "false");
+}
+
+void test_fused_where_1d()
+{
+    std::string x = "hstack(1., 5., 3., 7.)";
+
+    test_fused_where(x + " > 4", x, "0");
+    test_fused_where(x + " < 4", "1", "hstack(10, 20, 30, 40)");
+    test_fused_where(x + " >= hstack(1, 6, 2, 8)", x, "-1.");
+    test_fused_where("4 != " + x, "hstack(1, 2, 3, 4)", "42");
+    test_fused_where("hstack(1, 2, 3, 4) == 3", "true", "false");
+}
+
+void test_fused_where_2d()
+{
+    std::string x = "vstack(hstack(1., 5., 3.), hstack(7., 2., 9.))";
+
+    test_fused_where(x + " > 4", x, "0");
+    test_fused_where(x + " <= hstack(2, 2, 9)", x, "hstack(-1, -2, -3)");
+    test_fused_where(x + " == " + x, "1", x);
+    test_fused_where("hstack(1, 5, 3) != " + x, x,
+        "vstack(hstack(0, 0, 0), hstack(1, 1, 1))");
+}
+
+int main()
+{
+    test_compiler_recognition();
+
+    test_fused_where_0d();
+    test_fused_where_1d();
+    test_fused_where_2d();
+
+    return hpx::util::report_errors();
+}
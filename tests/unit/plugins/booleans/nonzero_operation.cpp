@@ -9,9 +9,12 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
+#include <blaze/Math.h>
+
 ///////////////////////////////////////////////////////////////////////////////
 phylanx::execution_tree::primitive_argument_type compile_and_run(
     std::string const& codestr)
@@ -31,6 +34,40 @@ void test_nonzero_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// matrices spanning several blocks of the parallel index extraction, the
+// blocks start in the middle of rows
+void test_nonzero_operation_2d_blocks()
+{
+    std::size_t const rows = 1000;
+    std::size_t const columns = 301;
+
+    auto result = phylanx::execution_tree::extract_list_value(
+        compile_and_run("nonzero(constant(1, make_list(1000, 301)))"));
+
+    blaze::DynamicVector<std::int64_t> expected_rows(rows * columns);
+    blaze::DynamicVector<std::int64_t> expected_columns(rows * columns);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            expected_rows[i * columns + j] = std::int64_t(i);
+            expected_columns[i * columns + j] = std::int64_t(j);
+        }
+    }
+
+    HPX_TEST_EQ(result.size(), 2);
+
+    auto it = result.begin();
+    HPX_TEST_EQ(*it,
+        phylanx::execution_tree::primitive_argument_type{
+            phylanx::ir::node_data<std::int64_t>{std::move(expected_rows)}});
+    ++it;
+    HPX_TEST_EQ(*it,
+        phylanx::execution_tree::primitive_argument_type{
+            phylanx::ir::node_data<std::int64_t>{
+                std::move(expected_columns)}});
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -59,6 +96,12 @@ int main(int argc, char* argv[])
     test_nonzero_operation(
         "nonzero(hstack(1., 0., 42., 43.))", "list(hstack(0, 2, 3))");
 
+    // vectors spanning several blocks of the parallel index extraction
+    test_nonzero_operation("nonzero(constant(1, 200000))",
+        "list(arange(0, 200000, 1))");
+    test_nonzero_operation("nonzero(arange(0, 200000, 1))",
+        "list(arange(1, 200000, 1))");
+
     // test 2d data (matrix)
     test_nonzero_operation(
         "nonzero(vstack(hstack()))", "list(hstack(), hstack())");
@@ -73,5 +116,7 @@ int main(int argc, char* argv[])
         "nonzero(vstack(hstack(0., 1.), hstack(2., 0.)))",
         "list(hstack(0, 1), hstack(1, 0))");
 
+    test_nonzero_operation_2d_blocks();
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,118 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test is run with phylanx.fuse_where=0, i.e. where(lhs <op> rhs, a, b)
+// is compiled into the comparison followed by where(). The results are
+// compared with the fused primitives invoked explicitly.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+std::string compiled_name(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    return phylanx::execution_tree::compile(codestr, snippets, env).name_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_unfused_where(std::string const& fused_name, std::string const& op,
+    std::string const& lhs, std::string const& rhs, std::string const& a,
+    std::string const& b)
+{
+    std::string unfused =
+        "where(" + lhs + " " + op + " " + rhs + ", " + a + ", " + b + ")";
+    std::string fused = fused_name + "(" + lhs + ", " + rhs + ", " + a +
+        ", " + b + ")";
+
+    HPX_TEST_EQ(compile_and_run(unfused), compile_and_run(fused));
+}
+
+void test_configuration()
+{
+    HPX_TEST(compiled_name("where(1 < 2, 1, 2)").find("__where_") ==
+        std::string::npos);
+}
+
+void test_scalar_lhs()
+{
+    std::string v = "hstack(1., 5., 3., 7.)";
+    std::string m = "vstack(hstack(1., 5., 3.), hstack(7., 2., 9.))";
+
+    test_unfused_where("__where_lt", "<", "4", v, v, "0");
+    test_unfused_where("__where_le", "<=", "3", v, v, "0");
+    test_unfused_where("__where_gt", ">", "4", v, "1", "hstack(1, 2, 3, 4)");
+    test_unfused_where("__where_ge", ">=", "5.", v, v, "-1.");
+
+    test_unfused_where("__where_lt", "<", "4", m, m, "0");
+    test_unfused_where("__where_le", "<=", "3", m, "1", m);
+    test_unfused_where("__where_gt", ">", "4", m, m, "hstack(-1, -2, -3)");
+    test_unfused_where("__where_ge", ">=", "5.", m, m, "0");
+}
+
+void test_vector_lhs()
+{
+    std::string v = "hstack(2., 5., 3.)";
+    std::string m = "vstack(hstack(1., 5., 3.), hstack(7., 2., 9.))";
+
+    test_unfused_where("__where_lt", "<", v, m, m, "0");
+    test_unfused_where("__where_le", "<=", v, m, m, "0");
+    test_unfused_where("__where_gt", ">", v, m, "1", "0");
+    test_unfused_where("__where_ge", ">=", v, m, m, v);
+}
+
+void test_bool_double()
+{
+    std::string v = "hstack(1., 5., 3., 7.)";
+    std::string mask = "(" + v + " > 2.)";
+    std::string mm = "(vstack(hstack(1., 5.), hstack(7., 2.)) > 2.)";
+
+    test_unfused_where("__where_eq", "==", mask, "2.0", v, "0");
+    test_unfused_where("__where_ne", "!=", mask, "2.0", v, "0");
+    test_unfused_where("__where_lt", "<", mask, "0.5", v, "0");
+    test_unfused_where("__where_ge", ">=", "0.5", mask, v, "0");
+    test_unfused_where("__where_gt", ">", mask, "hstack(0., 2., 0., 0.5)",
+        v, "-1.");
+    test_unfused_where("__where_le", "<=", mm, "2.0", "1", "0");
+    test_unfused_where("__where_eq", "==", "true", "2.0", "1", "0");
+}
+
+void test_non_numeric()
+{
+    test_unfused_where(
+        "__where_eq", "==", "\"abc\"", "\"abc\"", "1", "2");
+    test_unfused_where(
+        "__where_ne", "!=", "\"abc\"", "\"abc\"", "hstack(1, 2)", "0");
+}
+
+int main()
+{
+    test_configuration();
+
+    test_scalar_lhs();
+    test_vector_lhs();
+    test_bool_double();
+    test_non_numeric();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,90 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_parallel_for_each(std::string const& grain_size)
+{
+    std::string const code = R"(block(
+            define(a, constant(0, 100)),
+            parallel_for_each(
+                lambda(i, store(slice(a, i), i * i)), range(100))" +
+                grain_size + R"(),
+            a
+        ))";
+
+    auto result =
+        phylanx::execution_tree::extract_numeric_value(compile_and_run(code));
+
+    HPX_TEST_EQ(result.size(), std::size_t(100));
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        HPX_TEST_EQ(result[i], double(i * i));
+    }
+}
+
+void test_parallel_for_each_list()
+{
+    std::string const code = R"(block(
+            define(a, constant(0, 3)),
+            parallel_for_each(
+                lambda(x, store(slice(a, x), x + 1)), list(0, 1, 2), 1),
+            a
+        ))";
+
+    auto result =
+        phylanx::execution_tree::extract_numeric_value(compile_and_run(code));
+
+    HPX_TEST_EQ(result[0], 1.0);
+    HPX_TEST_EQ(result[1], 2.0);
+    HPX_TEST_EQ(result[2], 3.0);
+}
+
+void test_parallel_for_each_negative_grain_size()
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run("parallel_for_each(lambda(x, x), range(10), -1)");
+    }
+    catch (hpx::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_parallel_for_each("");
+    test_parallel_for_each(", 1");
+    test_parallel_for_each(", 7");
+    test_parallel_for_each(", 1000");
+    test_parallel_for_each_list();
+    test_parallel_for_each_negative_grain_size();
+
+    return hpx::util::report_errors();
+}
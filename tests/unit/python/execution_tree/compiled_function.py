@@ -0,0 +1,65 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+from phylanx import Phylanx
+import numpy as np
+
+et = phylanx.execution_tree
+cs = phylanx.compiler_state()
+
+# compile once, invoke many times
+fib = et.compiled_function(
+    """
+block(
+    define(fib,n,
+    if(n<2,n,
+        fib(n-1)+fib(n-2))),
+    fib)""", cs)
+
+for i in range(100):
+    assert fib(10) == 55.0
+assert fib(12) == 144.0
+assert fib.call_async(15).result() == 610.0
+
+
+@Phylanx
+def scale(a, s):
+    return a * s
+
+
+v = np.arange(10)
+for i in range(100):
+    assert (scale(v, i) == v * i).all()
+
+assert scale.backend.compiled_function() is scale.backend.compiled_function()
+
+# evaluate many argument sets at once
+assert fib.map_batch([(i, ) for i in range(10)]) == \
+    [0.0, 1.0, 1.0, 2.0, 3.0, 5.0, 8.0, 13.0, 21.0, 34.0]
+assert et.map_batch(fib, [10, 12]) == [55.0, 144.0]
+
+results = et.map_batch(scale, [(v, i) for i in range(10)])
+assert len(results) == 10
+for i, r in enumerate(results):
+    assert (r == v * i).all()
+
+
+# the local variables of a function are shared by all of its invocations,
+# concurrent invocations must not interfere with each other
+@Phylanx
+def scale_shift(a, s):
+    t = a * s
+    t = t + s
+    return t
+
+
+results = scale_shift.map_batch([(v, i) for i in range(100)])
+for i, r in enumerate(results):
+    assert (r == v * i + i).all()
+
+futures = [scale_shift.call_async(v, i) for i in range(100)]
+for i, f in enumerate(futures):
+    assert (f.result() == v * i + i).all()
@@ -0,0 +1,64 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+from phylanx import Phylanx
+import numpy as np
+
+et = phylanx.execution_tree
+
+
+@Phylanx(lazy=True)
+def f(x):
+    return x * 2.0
+
+
+@Phylanx(lazy=True)
+def g(x, y):
+    return x + y
+
+
+@Phylanx
+def h(x):
+    return x - 1.0
+
+
+x_np = np.array([1.0, 2.0, 3.0])
+x = et.lazy_array(x_np)
+
+# calls are composed into one graph, nothing is evaluated yet
+a = f(x)
+b = g(a, f(a))
+assert isinstance(b, et.lazy_array)
+assert b.primitive == 'g'
+assert np.allclose(b.compute(), x_np * 2.0 + x_np * 4.0)
+
+# eagerly evaluated functions can be deferred explicitly, deferred calls
+# compose with numpy operations
+c = np.sqrt(h.lazy(b)) + f(x_np)
+assert np.allclose(np.asarray(c), np.sqrt(x_np * 6.0 - 1.0) + x_np * 2.0)
+assert h(3.0) == 2.0
+
+# intermediate results can be kept on the C++ side
+b.evaluate()
+assert np.allclose(g(b, b).compute(), x_np * 12.0)
+
+
+
+# functions keep using the state they were compiled into, even after another
+# function selected a different one
+@Phylanx
+def m(x):
+    return x + 1.0
+
+
+@Phylanx(compiler_state=phylanx.compiler_state())
+def k(x):
+    return x * 3.0
+
+
+assert np.allclose(m.lazy(x_np).compute(), x_np + 1.0)
+assert m(3.0) == 4.0
+assert k(1.0) == 3.0
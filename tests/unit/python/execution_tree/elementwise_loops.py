@@ -0,0 +1,61 @@
+#  Copyright (c) 2018 R. Tohid
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+from phylanx import Phylanx
+import numpy as np
+
+
+# elementwise loops are replaced with whole array operations
+@Phylanx
+def add(x, y, z):
+    for i in range(shape(x, 0)):
+        z[i] = x[i] + y[i]
+    return z
+
+
+assert 'for_each' not in add.__src__
+
+x = np.arange(10, dtype=float)
+y = np.arange(10, 20, dtype=float)
+assert (add(x, y, np.zeros(10)) == x + y).all()
+
+
+@Phylanx
+def smooth(x, z):
+    for i in range(1, shape(x, 0) - 1):
+        z[i] = (x[i - 1] + x[i] + x[i + 1]) / 3.0
+        z[i] += 2.0 * x[i]
+    return z
+
+
+assert 'for_each' not in smooth.__src__
+
+expected = np.zeros(10)
+expected[1:-1] = (x[:-2] + x[1:-1] + x[2:]) / 3.0 + 2.0 * x[1:-1]
+assert np.allclose(smooth(x, np.zeros(10)), expected)
+
+
+# reading values written by earlier iterations requires the loop
+@Phylanx
+def propagate(x):
+    for i in range(1, shape(x, 0)):
+        x[i] = x[i - 1]
+    return x
+
+
+assert 'for_each' in propagate.__src__
+assert (propagate(np.arange(10, dtype=float)) == np.zeros(10)).all()
+
+
+@Phylanx(vectorize=False)
+def add_loop(x, y, z):
+    for i in range(shape(x, 0)):
+        z[i] = x[i] + y[i]
+    return z
+
+
+assert 'for_each' in add_loop.__src__
+assert (add_loop(x, y, np.zeros(10)) == x + y).all()
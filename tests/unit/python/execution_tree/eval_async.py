@@ -0,0 +1,57 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import asyncio
+import threading
+import phylanx
+from phylanx import Phylanx
+
+et = phylanx.execution_tree
+cs = phylanx.compiler_state()
+
+fib_src = """
+block(
+    define(fib,n,
+    if(n<2,n,
+        fib(n-1)+fib(n-2))),
+    fib)"""
+
+# wait for the result explicitly
+f = et.eval_async(fib_src, cs, 10)
+assert f.result() == 55.0
+assert f.done()
+
+# callbacks are invoked once the result is available
+called = []
+event = threading.Event()
+
+
+def on_done(fut):
+    called.append(fut.result())
+    event.set()
+
+
+f.add_done_callback(on_done)
+assert event.wait(10)
+assert called == [55.0]
+
+
+@Phylanx
+def fib(n):
+    if n < 2:
+        return n
+    else:
+        return fib(n - 1) + fib(n - 2)
+
+
+# overlap several invocations from within an asyncio event loop
+async def run_all():
+    return await asyncio.gather(
+        fib.call_async(10), fib.call_async(12), fib.call_async(15))
+
+
+loop = asyncio.get_event_loop()
+assert loop.run_until_complete(run_all()) == [55.0, 144.0, 610.0]
+
@@ -0,0 +1,42 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+import numpy as np
+
+et = phylanx.execution_tree
+
+a_np = np.array([[1.0, 2.0], [3.0, 4.0]])
+b_np = np.array([[5.0, 6.0], [7.0, 8.0]])
+
+a = et.lazy_array(a_np)
+b = et.lazy_array(b_np)
+
+# operations are recorded, not executed
+c = np.exp(a + b * 2.0) - a
+assert isinstance(c, et.lazy_array)
+assert c.primitive == '__sub'
+assert np.allclose(np.asarray(c), np.exp(a_np + b_np * 2.0) - a_np)
+
+# numpy functions dispatch to PhySL as well
+d = np.dot(a, b)
+assert isinstance(d, et.lazy_array)
+assert np.allclose(np.asarray(d), np.dot(a_np, b_np))
+assert np.allclose(np.asarray(a @ b), a_np @ b_np)
+assert np.allclose(np.asarray(a.T), a_np.T)
+assert float(np.sum(a)) == 10.0
+
+# evaluated results stay on the C++ side and can be used further
+e = (a + b).evaluate()
+assert e.variable is not None and e.primitive is None
+assert np.allclose(np.asarray(e * e), (a_np + b_np) * (a_np + b_np))
+
+# expressions of the same structure reuse the compiled function
+count = len(et.lazy_array.__compiled_functions__)
+assert np.allclose(np.asarray(b + a), b_np + a_np)
+assert len(et.lazy_array.__compiled_functions__) == count
+
+# unsupported operations fall back to numpy
+assert np.allclose(np.cumprod(a), np.cumprod(a_np))
@@ -0,0 +1,64 @@
+#  Copyright (c) 2018 R. Tohid
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+from phylanx import Phylanx
+import numpy as np
+
+
+# the loops of a matrix multiplication are interchanged (i, k, j) and tiled
+@Phylanx(tiling=True, tile_size=4)
+def matmul(a, b, c):
+    for i in range(shape(a, 0)):
+        for j in range(shape(b, 1)):
+            for k in range(shape(a, 1)):
+                c[i, j] += a[i, k] * b[k, j]
+    return c
+
+
+assert 'i_tile' in matmul.__src__
+assert matmul.__src__.index('k_tile') < matmul.__src__.index('j_tile')
+
+a = np.arange(30, dtype=float).reshape((5, 6))
+b = np.arange(42, dtype=float).reshape((6, 7))
+assert np.allclose(matmul(a, b, np.zeros((5, 7))), np.dot(a, b))
+
+
+# dependencies in both directions prevent the transformation
+@Phylanx(tiling=True, tile_size=4)
+def skewed(a):
+    for i in range(1, shape(a, 0)):
+        for j in range(shape(a, 1) - 1):
+            a[i, j] = a[i - 1, j + 1] + 1.0
+    return a
+
+
+assert '_tile' not in skewed.__src__
+
+c = np.ones((6, 6))
+expected = c.copy()
+for i in range(1, 6):
+    for j in range(5):
+        expected[i, j] = expected[i - 1, j + 1] + 1.0
+assert np.allclose(skewed(c), expected)
+
+
+# a wavefront (non-negative dependence distances) is tiled
+@Phylanx(tiling=True, tile_size=4)
+def wavefront(a):
+    for i in range(1, shape(a, 0)):
+        for j in range(1, shape(a, 1)):
+            a[i, j] = a[i - 1, j] + a[i, j - 1]
+    return a
+
+
+assert 'i_tile' in wavefront.__src__
+
+c = np.ones((9, 9))
+expected = c.copy()
+for i in range(1, 9):
+    for j in range(1, 9):
+        expected[i, j] = expected[i - 1, j] + expected[i, j - 1]
+assert np.allclose(wavefront(c), expected)
@@ -0,0 +1,69 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+from phylanx import Phylanx
+from phylanx.util import prange
+import numpy as np
+
+
+# independent iterations are executed concurrently
+@Phylanx
+def squares(a):
+    for i in prange(0, 100):
+        a[i] = i * i
+    return a
+
+
+assert 'parallel_for_each' in squares.__src__
+assert (squares(np.zeros(100)) == np.arange(100) ** 2).all()
+
+
+@Phylanx
+def squares_chunked(a):
+    for i in prange(0, 100, grain_size=16):
+        a[i] = i * i
+    return a
+
+
+assert 'parallel_for_each' in squares_chunked.__src__
+assert (squares_chunked(np.zeros(100)) == np.arange(100) ** 2).all()
+
+
+# loop carried dependencies force sequential execution
+@Phylanx
+def prefix_sum(a):
+    for i in prange(1, 10):
+        a[i] = a[i - 1] + a[i]
+    return a
+
+
+assert 'parallel_for_each' not in prefix_sum.__src__
+assert (prefix_sum(np.ones(10)) == np.arange(1, 11)).all()
+
+
+# temporaries are shared by all iterations
+@Phylanx
+def scale(a, x):
+    for i in prange(0, 10):
+        t = x[i] * 2
+        a[i] = t
+    return a
+
+
+assert 'parallel_for_each' not in scale.__src__
+assert (scale(np.zeros(10), np.arange(10.0)) == 2 * np.arange(10.0)).all()
+
+
+@Phylanx
+def reduction():
+    s = 0
+    for i in prange(0, 10):
+        s += i
+    return s
+
+
+assert 'parallel_for_each' not in reduction.__src__
+assert reduction() == 45
@@ -0,0 +1,36 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+import numpy as np
+
+et = phylanx.execution_tree
+cs = phylanx.compiler_state()
+
+# the measurements are enabled for primitives which exist already
+add = et.compiled_function("define(add, x, y, x + y)\nadd", cs)
+
+enabled = phylanx.util.enable_measurements(size_histogram=True)
+assert len(enabled) != 0
+
+# the 100x10 matrices fall into size class 9 (512 <= 1000 < 1024)
+v = np.ones((100, 10))
+assert (add(v, v) == 2 * v).all()
+
+histogram = phylanx.util.retrieve_size_histogram(reset=True)
+
+found_add = False
+for name, buckets in histogram.items():
+    assert len(buckets) == 32
+    if '__add' in name:
+        found_add = True
+        for k, (count, duration) in enumerate(buckets):
+            assert count == (1 if k == 9 else 0)
+            assert (duration != 0) == (k == 9)
+assert found_add
+
+# the data was reset by the previous retrieval, primitives without any
+# recorded evaluation are not reported
+assert len(phylanx.util.retrieve_size_histogram()) == 0
@@ -0,0 +1,63 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_streaming_reductions()
+{
+    std::vector<std::uint8_t> v(200, 0);
+
+    auto pred = [&](std::size_t i) { return v[i] != 0; };
+
+    HPX_TEST(!phylanx::util::mask_any(v.size(), pred));
+    HPX_TEST(!phylanx::util::mask_all(v.size(), pred));
+    HPX_TEST_EQ(phylanx::util::mask_count(v.size(), pred), std::size_t(0));
+
+    v[199] = 1;
+    HPX_TEST(phylanx::util::mask_any(v.size(), pred));
+    HPX_TEST_EQ(phylanx::util::mask_count(v.size(), pred), std::size_t(1));
+
+    std::fill(v.begin(), v.end(), 1);
+    HPX_TEST(phylanx::util::mask_all(v.size(), pred));
+    HPX_TEST_EQ(phylanx::util::mask_count(v.size(), pred), std::size_t(200));
+
+    HPX_TEST(phylanx::util::mask_all(0, pred));
+    HPX_TEST(!phylanx::util::mask_any(0, pred));
+}
+
+void test_mask_for_each()
+{
+    // spans more than two words, last word partially used
+    std::vector<double> v(150, 0.0);
+    v[0] = 1.0;
+    v[63] = 2.0;
+    v[64] = 3.0;
+    v[149] = 4.0;
+
+    std::vector<std::size_t> indices;
+    phylanx::util::mask_for_each(v.size(),
+        [&](std::size_t i) { return v[i] != 0; },
+        [&](std::size_t i) { indices.push_back(i); });
+
+    std::vector<std::size_t> expected = {0, 63, 64, 149};
+    HPX_TEST(indices == expected);
+}
+
+int main()
+{
+    test_streaming_reductions();
+    test_mask_for_each();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,98 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(x, constant(1.0, make_list(10, 4))),
+    define(y, constant(2.0, make_list(10, 4))),
+    x + y
+))";
+
+phylanx::execution_tree::primitive_argument_type evaluate()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(
+        phylanx::ast::generate_ast(code), snippets);
+    return f.run()();
+}
+
+void test_trace_disabled()
+{
+    phylanx::util::retrieve_eval_trace(true);
+
+    evaluate();
+
+    HPX_TEST(phylanx::util::retrieve_eval_trace(true).empty());
+}
+
+void test_trace_events()
+{
+    phylanx::util::enable_eval_trace(true);
+    evaluate();
+    phylanx::util::enable_eval_trace(false);
+
+    std::vector<phylanx::util::eval_trace_event> events =
+        phylanx::util::retrieve_eval_trace(true);
+    HPX_TEST(!events.empty());
+
+    bool found_add = false;
+    for (auto const& e : events)
+    {
+        HPX_TEST(e.end_ >= e.begin_);
+
+        std::string name(e.name_);
+        if (name.find("/phylanx/__add$") == 0)
+        {
+            found_add = true;
+            HPX_TEST_EQ(e.result_shape_[0], 2);
+            HPX_TEST_EQ(e.result_shape_[1], 10);
+            HPX_TEST_EQ(e.result_shape_[2], 4);
+        }
+    }
+    HPX_TEST(found_add);
+
+    std::ostringstream os;
+    phylanx::util::write_chrome_trace(os, events);
+
+    std::string json = os.str();
+    HPX_TEST(json.find("{\"traceEvents\":[") == 0);
+    HPX_TEST(json.find("\"ph\":\"X\"") != std::string::npos);
+    HPX_TEST(json.find("\"result\":[10,4]") != std::string::npos);
+}
+
+void test_ring_buffer()
+{
+    // a buffer smaller than the number of evaluations keeps the newest events
+    phylanx::util::enable_eval_trace(true, 4);
+    evaluate();
+    evaluate();
+    phylanx::util::enable_eval_trace(false);
+
+    std::vector<phylanx::util::eval_trace_event> events =
+        phylanx::util::retrieve_eval_trace(true);
+    HPX_TEST_EQ(events.size(), std::size_t(4));
+
+    HPX_TEST(phylanx::util::retrieve_eval_trace().empty());
+}
+
+int main()
+{
+    test_trace_disabled();
+    test_trace_events();
+    test_ring_buffer();
+
+    return hpx::util::report_errors();
+}
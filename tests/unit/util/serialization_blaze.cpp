@@ -0,0 +1,177 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+T round_trip(T const& value)
+{
+    std::vector<char> buf;
+    hpx::serialization::output_archive oar(buf);
+    oar << value;
+
+    hpx::serialization::input_archive iar(buf);
+    T result;
+    iar >> result;
+    return result;
+}
+
+template <typename T>
+void test_vector(std::size_t size)
+{
+    blaze::DynamicVector<T> v(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = T(i % 127);
+    }
+
+    HPX_TEST_EQ(round_trip(v), v);
+}
+
+template <typename T, bool SO>
+void test_matrix(std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicMatrix<T, SO> m(rows, columns);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            m(i, j) = T((i * columns + j) % 127);
+        }
+    }
+
+    HPX_TEST_EQ(round_trip(m), m);
+}
+
+// a custom matrix referring to some of the rows of a larger buffer has a
+// spacing which differs from the one of the received dynamic matrix
+void test_custom_matrix()
+{
+    std::size_t const rows = 5;
+    std::size_t const columns = 3;
+    std::size_t const spacing = 11;
+
+    std::vector<double> buffer(rows * spacing, -1.0);
+    blaze::CustomMatrix<double, blaze::unaligned, blaze::unpadded> m(
+        buffer.data(), rows, columns, spacing);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            m(i, j) = double(i * columns + j);
+        }
+    }
+
+    std::vector<char> buf;
+    hpx::serialization::output_archive oar(buf);
+    oar << m;
+
+    hpx::serialization::input_archive iar(buf);
+    blaze::DynamicMatrix<double> result;
+    iar >> result;
+
+    HPX_TEST_EQ(result, m);
+}
+
+// the padding of a received matrix is zero even if the sender's padding
+// elements, which are sent along, are not
+void test_nonzero_padding()
+{
+    std::size_t const rows = 5;
+    std::size_t const columns = 3;
+
+    // use the same spacing as the received dynamic matrix
+    std::size_t const spacing =
+        blaze::DynamicMatrix<double>(rows, columns).spacing();
+
+    std::vector<double> buffer(rows * spacing, -1.0);
+    blaze::CustomMatrix<double, blaze::unaligned, blaze::unpadded> m(
+        buffer.data(), rows, columns, spacing);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            m(i, j) = double(i * columns + j);
+        }
+    }
+
+    std::vector<char> buf;
+    hpx::serialization::output_archive oar(buf);
+    oar << m;
+
+    hpx::serialization::input_archive iar(buf);
+    blaze::DynamicMatrix<double> result;
+    iar >> result;
+
+    HPX_TEST_EQ(result, m);
+    HPX_TEST_EQ(result.spacing(), spacing);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = columns; j != spacing; ++j)
+        {
+            HPX_TEST_EQ(result.data()[i * spacing + j], 0.0);
+        }
+    }
+}
+
+// large arrays are sent as zero-copy chunks referring to the original data
+void test_zero_copy()
+{
+    blaze::DynamicMatrix<double> m(256, 255, 42.0);
+
+    std::vector<char> buf;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    hpx::serialization::output_archive oar(buf, 0U, &chunks);
+    oar << m;
+
+    bool found_pointer_chunk = false;
+    for (auto const& chunk : chunks)
+    {
+        if (chunk.type_ == hpx::serialization::chunk_type_pointer &&
+            chunk.data_.cpos_ == m.data())
+        {
+            found_pointer_chunk = true;
+        }
+    }
+    HPX_TEST(found_pointer_chunk);
+
+    hpx::serialization::input_archive iar(buf, buf.size(), &chunks);
+    blaze::DynamicMatrix<double> result;
+    iar >> result;
+
+    HPX_TEST_EQ(result, m);
+}
+
+int main()
+{
+    test_vector<double>(0);
+    test_vector<double>(13);
+    test_vector<std::int64_t>(1001);
+    test_vector<std::uint8_t>(33);
+
+    test_matrix<double, blaze::rowMajor>(0, 0);
+    test_matrix<double, blaze::rowMajor>(7, 5);
+    test_matrix<double, blaze::columnMajor>(7, 5);
+    test_matrix<std::int64_t, blaze::rowMajor>(100, 3);
+    test_matrix<std::uint8_t, blaze::columnMajor>(9, 17);
+
+    test_custom_matrix();
+    test_nonzero_padding();
+    test_zero_copy();
+
+    return hpx::util::report_errors();
+}